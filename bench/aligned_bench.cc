@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+constexpr std::size_t kMaxThreads = 64;
+
+// Counters of neighbouring threads share cache lines.
+struct PackedCounters {
+  std::atomic<long> &Get(std::size_t thread) { return *counters[thread]; }
+  dizing::array<dizing::padded<std::atomic<long>, alignof(long)>, kMaxThreads>
+      counters = {};
+};
+
+// Every counter on its own cache line.
+struct PaddedCounters {
+  std::atomic<long> &Get(std::size_t thread) { return *counters[thread]; }
+  dizing::array<dizing::padded<std::atomic<long>>, kMaxThreads> counters = {};
+};
+
+struct PerCoreCounters {
+  std::atomic<long> &Get(std::size_t) { return counters.local(); }
+  dizing::per_core_array<std::atomic<long>> counters =
+      dizing::per_core_array<std::atomic<long>>();
+};
+
+// Every thread increments its own counter in an array shared by all
+// threads, as per-thread statistics do.
+template <typename Counters>
+void BM_CounterIncrements(benchmark::State &state) {
+  static Counters counters;
+  std::atomic<long> &counter =
+      counters.Get(static_cast<std::size_t>(state.thread_index()));
+  for (auto _ : state) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+  SetItems(state, 1);
+}
+
+// From 1 thread up to one per hardware thread.
+void CounterThreads(benchmark::internal::Benchmark *benchmark) {
+  int threads = static_cast<int>(std::min<unsigned>(
+      kMaxThreads, std::max(1u, std::thread::hardware_concurrency())));
+  for (int count = 1; count <= threads; count *= 2) {
+    benchmark->Threads(count);
+  }
+  benchmark->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_CounterIncrements, PackedCounters)
+    ->Apply(CounterThreads);
+BENCHMARK_TEMPLATE(BM_CounterIncrements, PaddedCounters)
+    ->Apply(CounterThreads);
+BENCHMARK_TEMPLATE(BM_CounterIncrements, PerCoreCounters)
+    ->Apply(CounterThreads);
@@ -0,0 +1,57 @@
+#include <array>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+template <typename Array>
+void BM_ArrayFill(benchmark::State &state) {
+  using value_type = typename Array::value_type;
+  const value_type value = MakeValue<value_type>(42);
+  Array array{};
+  for (auto _ : state) {
+    array.fill(value);
+    benchmark::DoNotOptimize(array.data());
+    benchmark::ClobberMemory();
+  }
+  SetItems(state, array.size());
+}
+
+template <typename Array>
+void BM_ArraySwap(benchmark::State &state) {
+  using value_type = typename Array::value_type;
+  Array first{};
+  Array second{};
+  first.fill(MakeValue<value_type>(1));
+  second.fill(MakeValue<value_type>(2));
+  for (auto _ : state) {
+    first.swap(second);
+    benchmark::DoNotOptimize(first.data());
+    benchmark::DoNotOptimize(second.data());
+    benchmark::ClobberMemory();
+  }
+  SetItems(state, first.size());
+}
+
+}  // namespace
+
+// Registers func for dizing::array and std::array of all element types and
+// sizes 16 and 1024.
+#define ARRAY_BENCHMARK_VS_STD(func)                      \
+  BENCHMARK_TEMPLATE(func, dizing::array<int, 16>);       \
+  BENCHMARK_TEMPLATE(func, std::array<int, 16>);          \
+  BENCHMARK_TEMPLATE(func, dizing::array<int, 1024>);     \
+  BENCHMARK_TEMPLATE(func, std::array<int, 1024>);        \
+  BENCHMARK_TEMPLATE(func, dizing::array<Pod64, 16>);     \
+  BENCHMARK_TEMPLATE(func, std::array<Pod64, 16>);        \
+  BENCHMARK_TEMPLATE(func, dizing::array<Pod64, 1024>);   \
+  BENCHMARK_TEMPLATE(func, std::array<Pod64, 1024>);      \
+  BENCHMARK_TEMPLATE(func, dizing::array<Record, 16>);    \
+  BENCHMARK_TEMPLATE(func, std::array<Record, 16>);       \
+  BENCHMARK_TEMPLATE(func, dizing::array<Record, 1024>);  \
+  BENCHMARK_TEMPLATE(func, std::array<Record, 1024>)
+
+ARRAY_BENCHMARK_VS_STD(BM_ArrayFill);
+ARRAY_BENCHMARK_VS_STD(BM_ArraySwap);
@@ -0,0 +1,278 @@
+#if !defined(CONTAINERS_BENCH_BENCH_COMMON_H)
+#define CONTAINERS_BENCH_BENCH_COMMON_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+// Element types of the benchmarks: int, 64 byte POD and a record with heap
+// allocated strings like testClass.
+
+struct Pod64 {
+  std::uint64_t key;
+  std::uint64_t payload[7];
+};
+static_assert(sizeof(Pod64) == 64);
+
+inline bool operator<(const Pod64 &lhs, const Pod64 &rhs) {
+  return lhs.key < rhs.key;
+}
+inline bool operator==(const Pod64 &lhs, const Pod64 &rhs) {
+  return lhs.key == rhs.key;
+}
+
+// Copying a record costs two mallocs.
+struct Record {
+  std::string key;
+  std::string payload;
+};
+
+inline bool operator<(const Record &lhs, const Record &rhs) {
+  return lhs.key < rhs.key;
+}
+inline bool operator==(const Record &lhs, const Record &rhs) {
+  return lhs.key == rhs.key;
+}
+
+template <typename T>
+T MakeValue(std::size_t i);
+
+template <>
+inline int MakeValue<int>(std::size_t i) {
+  return static_cast<int>(i);
+}
+
+template <>
+inline Pod64 MakeValue<Pod64>(std::size_t i) {
+  return {i, {i, i, i, i, i, i, i}};
+}
+
+template <>
+inline Record MakeValue<Record>(std::size_t i) {
+  return {"record-key-long-enough-for-heap-" + std::to_string(i),
+          std::string(48, 'p')};
+}
+
+inline std::size_t KeyOf(int value) { return static_cast<std::size_t>(value); }
+inline std::size_t KeyOf(const Pod64 &value) { return value.key; }
+inline std::size_t KeyOf(const Record &value) { return value.key.size(); }
+
+// Pseudo random sequence, same for every container.
+inline std::vector<std::size_t> RandomIndices(std::size_t count) {
+  std::vector<std::size_t> indices;
+  std::uint32_t seed = 12345;
+  for (std::size_t i = 0; i < count; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    indices.push_back(seed >> 8);
+  }
+  return indices;
+}
+
+template <typename Container>
+void Fill(Container &container, std::size_t count) {
+  using value_type = typename Container::value_type;
+  for (std::size_t i = 0; i < count; ++i) {
+    container.push_back(MakeValue<value_type>(i));
+  }
+}
+
+inline void SetItems(benchmark::State &state, std::size_t count) {
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(count));
+}
+
+// Element counts of O(n) and O(n^2) benchmarks.
+inline void LinearSizes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+}
+inline void QuadraticSizes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->RangeMultiplier(16)->Range(1 << 8, 1 << 12);
+}
+
+// Generic benchmarks of sequence containers, range(0) is element count.
+
+enum class Where { kFront, kMiddle, kBack };
+
+// Iterator to element at index, linear for lists.
+template <typename Container>
+typename Container::iterator Advance(Container &container,
+                                     std::size_t index) {
+  auto it = container.begin();
+  for (std::size_t i = 0; i < index; ++i) {
+    ++it;
+  }
+  return it;
+}
+
+template <typename Container>
+typename Container::iterator PositionOf(Container &container, Where where) {
+  switch (where) {
+    case Where::kFront:
+      return container.begin();
+    case Where::kMiddle:
+      return Advance(container, container.size() / 2);
+    default:
+      return container.end();
+  }
+}
+
+template <typename Container>
+void BM_PushBack(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    Container container;
+    Fill(container, count);
+    benchmark::DoNotOptimize(&container.back());
+    benchmark::ClobberMemory();
+  }
+  SetItems(state, count);
+}
+
+// Inserts count copies into a container of count elements at one position.
+template <typename Container>
+void BM_Insert(benchmark::State &state, Where where) {
+  using value_type = typename Container::value_type;
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const value_type value = MakeValue<value_type>(count);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container container;
+    Fill(container, count);
+    auto it = PositionOf(container, where);
+    state.ResumeTiming();
+    for (std::size_t i = 0; i < count; ++i) {
+      if (where == Where::kBack) {
+        container.insert(container.end(), value);
+      } else {
+        it = container.insert(it, value);
+      }
+    }
+    benchmark::DoNotOptimize(&container.back());
+    state.PauseTiming();
+    container.clear();
+    state.ResumeTiming();
+  }
+  SetItems(state, count);
+}
+
+// Erases count elements of a container of 2 * count elements at one
+// position.
+template <typename Container>
+void BM_Erase(benchmark::State &state, Where where) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container container;
+    Fill(container, 2 * count);
+    auto it = where == Where::kMiddle ? Advance(container, count / 2)
+                                      : container.begin();
+    state.ResumeTiming();
+    for (std::size_t i = 0; i < count; ++i) {
+      if (where == Where::kBack) {
+        container.pop_back();
+      } else {
+        it = container.erase(it);
+      }
+    }
+    benchmark::DoNotOptimize(&container.back());
+    state.PauseTiming();
+    container.clear();
+    state.ResumeTiming();
+  }
+  SetItems(state, count);
+}
+
+template <typename Container>
+void BM_InsertFront(benchmark::State &state) {
+  BM_Insert<Container>(state, Where::kFront);
+}
+template <typename Container>
+void BM_InsertMiddle(benchmark::State &state) {
+  BM_Insert<Container>(state, Where::kMiddle);
+}
+template <typename Container>
+void BM_InsertBack(benchmark::State &state) {
+  BM_Insert<Container>(state, Where::kBack);
+}
+template <typename Container>
+void BM_EraseFront(benchmark::State &state) {
+  BM_Erase<Container>(state, Where::kFront);
+}
+template <typename Container>
+void BM_EraseMiddle(benchmark::State &state) {
+  BM_Erase<Container>(state, Where::kMiddle);
+}
+template <typename Container>
+void BM_EraseBack(benchmark::State &state) {
+  BM_Erase<Container>(state, Where::kBack);
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Container container;
+  Fill(container, count);
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (const auto &value : container) {
+      sum += KeyOf(value);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state, count);
+}
+
+template <typename Container>
+void BM_Copy(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Container container;
+  Fill(container, count);
+  for (auto _ : state) {
+    Container copy(container);
+    benchmark::DoNotOptimize(&copy.back());
+  }
+  SetItems(state, count);
+}
+
+// Moves a container back and forth.
+template <typename Container>
+void BM_Move(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Container container;
+  Fill(container, count);
+  for (auto _ : state) {
+    Container moved(std::move(container));
+    benchmark::DoNotOptimize(&moved);
+    container = std::move(moved);
+    benchmark::DoNotOptimize(&container);
+  }
+}
+
+// Registers func for dizing::Container and std::Container of all element
+// types, sizes sets arguments.
+#define BENCHMARK_VS_STD(func, Container, sizes)                   \
+  BENCHMARK_TEMPLATE(func, dizing::Container<int>)->Apply(sizes);   \
+  BENCHMARK_TEMPLATE(func, std::Container<int>)->Apply(sizes);      \
+  BENCHMARK_TEMPLATE(func, dizing::Container<Pod64>)->Apply(sizes); \
+  BENCHMARK_TEMPLATE(func, std::Container<Pod64>)->Apply(sizes);    \
+  BENCHMARK_TEMPLATE(func, dizing::Container<Record>)->Apply(sizes); \
+  BENCHMARK_TEMPLATE(func, std::Container<Record>)->Apply(sizes)
+
+// Sequence benchmarks shared by vector and list. Insertion and erasure
+// at front and middle are quadratic for vectors and run on fewer elements.
+#define SEQUENCE_BENCHMARKS_VS_STD(Container)                    \
+  BENCHMARK_VS_STD(BM_PushBack, Container, LinearSizes);         \
+  BENCHMARK_VS_STD(BM_InsertFront, Container, QuadraticSizes);   \
+  BENCHMARK_VS_STD(BM_InsertMiddle, Container, QuadraticSizes);  \
+  BENCHMARK_VS_STD(BM_InsertBack, Container, LinearSizes);       \
+  BENCHMARK_VS_STD(BM_EraseFront, Container, QuadraticSizes);    \
+  BENCHMARK_VS_STD(BM_EraseMiddle, Container, QuadraticSizes);   \
+  BENCHMARK_VS_STD(BM_EraseBack, Container, LinearSizes);        \
+  BENCHMARK_VS_STD(BM_Iterate, Container, LinearSizes);          \
+  BENCHMARK_VS_STD(BM_Copy, Container, LinearSizes);             \
+  BENCHMARK_VS_STD(BM_Move, Container, LinearSizes)
+
+#endif  // CONTAINERS_BENCH_BENCH_COMMON_H
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+// Baseline: vector shared behind a mutex.
+template <typename T>
+class LockedVector {
+ public:
+  void push_back(const T &value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    vector_.push_back(value);
+  }
+
+ private:
+  std::mutex mutex_ = std::mutex();
+  dizing::vector<T> vector_ = dizing::vector<T>();
+};
+
+// Every thread appends one element per iteration to a vector shared by
+// all threads. The first thread creates it before the timed loop starts
+// and destroys it after all threads finished.
+template <typename Shared, typename T>
+void BM_ConcurrentAppend(benchmark::State &state) {
+  static std::unique_ptr<Shared> shared;
+  if (state.thread_index() == 0) {
+    shared = std::make_unique<Shared>();
+  }
+  T value = MakeValue<T>(static_cast<std::size_t>(state.thread_index()));
+  for (auto _ : state) {
+    shared->push_back(value);
+  }
+  if (state.thread_index() == 0) {
+    shared.reset();
+  }
+  SetItems(state, 1);
+}
+
+// From 1 thread up to one per hardware thread.
+void AppendThreads(benchmark::internal::Benchmark *benchmark) {
+  int threads = static_cast<int>(
+      std::max(1u, std::thread::hardware_concurrency()));
+  for (int count = 1; count <= threads; count *= 2) {
+    benchmark->Threads(count);
+  }
+  benchmark->UseRealTime();
+}
+
+}  // namespace
+
+#define CONCURRENT_APPEND_BENCHMARKS(T)                                    \
+  BENCHMARK_TEMPLATE(BM_ConcurrentAppend, dizing::concurrent_vector<T>, T) \
+      ->Apply(AppendThreads);                                              \
+  BENCHMARK_TEMPLATE(BM_ConcurrentAppend, LockedVector<T>, T)              \
+      ->Apply(AppendThreads)
+
+CONCURRENT_APPEND_BENCHMARKS(int);
+CONCURRENT_APPEND_BENCHMARKS(Pod64);
+CONCURRENT_APPEND_BENCHMARKS(Record);
@@ -0,0 +1,63 @@
+#include <deque>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+// Queue-like usage: a window of count elements slides by push_back and
+// pop_front.
+template <typename Queue>
+void BM_DequeQueue(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Queue queue;
+  Fill(queue, count);
+  int value = 0;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      queue.pop_front();
+      queue.push_back(++value);
+    }
+    benchmark::DoNotOptimize(&queue.back());
+  }
+  SetItems(state, count);
+}
+
+// Bursts: count elements are enqueued, then all of them are dequeued.
+template <typename Queue>
+void BM_DequeBurst(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Queue queue;
+  int value = 0;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      queue.push_back(++value);
+    }
+    while (!queue.empty()) {
+      benchmark::DoNotOptimize(queue.front());
+      queue.pop_front();
+    }
+  }
+  SetItems(state, count);
+}
+
+using PooledList = dizing::list<int, dizing::pool_allocator<int>>;
+
+void QueueSizes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->Range(1 << 6, 1 << 16);
+}
+
+}  // namespace
+
+SEQUENCE_BENCHMARKS_VS_STD(deque);
+
+// Registers func for deques and lists of ints used as queues.
+#define QUEUE_BENCHMARKS(func)                                     \
+  BENCHMARK_TEMPLATE(func, dizing::deque<int>)->Apply(QueueSizes); \
+  BENCHMARK_TEMPLATE(func, dizing::list<int>)->Apply(QueueSizes);  \
+  BENCHMARK_TEMPLATE(func, PooledList)->Apply(QueueSizes);         \
+  BENCHMARK_TEMPLATE(func, std::deque<int>)->Apply(QueueSizes)
+
+QUEUE_BENCHMARKS(BM_DequeQueue);
+QUEUE_BENCHMARKS(BM_DequeBurst);
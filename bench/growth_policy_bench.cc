@@ -0,0 +1,89 @@
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+using Item = std::array<char, 32>;
+
+template <typename Policy>
+using PolicyVector =
+    dizing::vector<Item, dizing::counting_allocator<Item>, Policy>;
+
+template <typename Vector>
+void Fill(Vector &vec, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    vec.emplace_back();
+  }
+}
+
+// Peak resident set of a child process running fn, in kilobytes.
+template <typename Function>
+long ChildPeakRssKb(Function fn) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    fn();
+    _exit(0);
+  }
+  int status = 0;
+  struct rusage usage = {};
+  wait4(pid, &status, 0, &usage);
+  return usage.ru_maxrss;
+}
+
+// Reports reallocation count, peak of live bytes (old and new buffers are
+// both alive during reallocation), unused capacity and peak RSS growth.
+template <typename Policy>
+void BM_GrowthPolicy(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  std::size_t unused_bytes = 0;
+  dizing::operation_counts counts;
+  for (auto _ : state) {
+    counts.reset();
+    PolicyVector<Policy> vec{dizing::counting_allocator<Item>(counts)};
+    Fill(vec, count);
+    benchmark::DoNotOptimize(vec.data());
+    unused_bytes = (vec.capacity() - vec.size()) * sizeof(Item);
+  }
+  state.counters["reallocations"] =
+      static_cast<double>(counts.allocations);
+  state.counters["peak_bytes"] = static_cast<double>(counts.peak_bytes);
+  state.counters["unused_bytes"] = static_cast<double>(unused_bytes);
+  long baseline_kb = ChildPeakRssKb([] {});
+  long peak_kb = ChildPeakRssKb([count] {
+    PolicyVector<Policy> vec;
+    Fill(vec, count);
+    benchmark::DoNotOptimize(vec.data());
+  });
+  state.counters["peak_rss_kb"] = static_cast<double>(peak_kb - baseline_kb);
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(count));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, dizing::doubling_growth<>)
+    ->Arg(8)
+    ->Arg(1 << 20)
+    ->Arg(3 << 19);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, dizing::doubling_growth<8>)
+    ->Arg(8)
+    ->Arg(1 << 20)
+    ->Arg(3 << 19);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, dizing::one_and_half_growth<8>)
+    ->Arg(8)
+    ->Arg(1 << 20)
+    ->Arg(3 << 19);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, dizing::page_rounded_growth<8>)
+    ->Arg(8)
+    ->Arg(1 << 20)
+    ->Arg(3 << 19);
+BENCHMARK_TEMPLATE(BM_GrowthPolicy, dizing::size_class_growth<8>)
+    ->Arg(8)
+    ->Arg(1 << 20)
+    ->Arg(3 << 19);
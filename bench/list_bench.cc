@@ -0,0 +1,126 @@
+#include <cstdint>
+#include <list>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+template <typename List>
+void FillRandom(List &list, std::size_t count) {
+  using value_type = typename List::value_type;
+  for (std::size_t index : RandomIndices(count)) {
+    list.push_back(MakeValue<value_type>(index));
+  }
+}
+
+template <typename List>
+void BM_ListSort(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    List list;
+    FillRandom(list, count);
+    state.ResumeTiming();
+    list.sort();
+    benchmark::DoNotOptimize(&list.front());
+    state.PauseTiming();
+    list.clear();
+    state.ResumeTiming();
+  }
+  SetItems(state, count);
+}
+
+// Merges two sorted lists of count elements.
+template <typename List>
+void BM_ListMerge(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    List first;
+    List second;
+    FillRandom(first, count);
+    FillRandom(second, count);
+    first.sort();
+    second.sort();
+    state.ResumeTiming();
+    first.merge(second);
+    benchmark::DoNotOptimize(&first.front());
+    state.PauseTiming();
+    first.clear();
+    second.clear();
+    state.ResumeTiming();
+  }
+  SetItems(state, count);
+}
+
+// Every value is repeated twice.
+template <typename List>
+void BM_ListUnique(benchmark::State &state) {
+  using value_type = typename List::value_type;
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    List list;
+    for (std::size_t i = 0; i < count; ++i) {
+      list.push_back(MakeValue<value_type>(i / 2));
+    }
+    state.ResumeTiming();
+    list.unique();
+    benchmark::DoNotOptimize(&list.front());
+    state.PauseTiming();
+    list.clear();
+    state.ResumeTiming();
+  }
+  SetItems(state, count);
+}
+
+template <typename List>
+void BM_ListReverse(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  List list;
+  Fill(list, count);
+  for (auto _ : state) {
+    list.reverse();
+    benchmark::DoNotOptimize(&list.front());
+  }
+  SetItems(state, count);
+}
+
+// Queue-like usage: a window of count elements slides by push_back and
+// pop_front, every node is freed and allocated again.
+template <typename List>
+void BM_ListQueue(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  List list;
+  Fill(list, count);
+  int value = 0;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      list.pop_front();
+      list.push_back(++value);
+    }
+    benchmark::DoNotOptimize(&list.back());
+  }
+  SetItems(state, count);
+}
+
+void SortSizes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(
+      benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+SEQUENCE_BENCHMARKS_VS_STD(list);
+BENCHMARK_VS_STD(BM_ListSort, list, SortSizes);
+BENCHMARK_VS_STD(BM_ListMerge, list, LinearSizes);
+BENCHMARK_VS_STD(BM_ListUnique, list, LinearSizes);
+BENCHMARK_VS_STD(BM_ListReverse, list, LinearSizes);
+
+BENCHMARK_TEMPLATE(BM_ListQueue, dizing::list<int>)->Range(1 << 6, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListQueue,
+                   dizing::list<int, dizing::pool_allocator<int>>)
+    ->Range(1 << 6, 1 << 16);
+BENCHMARK_TEMPLATE(BM_ListQueue, std::list<int>)->Range(1 << 6, 1 << 16);
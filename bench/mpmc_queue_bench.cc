@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+constexpr std::size_t kCapacity = 1024;
+constexpr std::size_t kBatch = 16;
+
+// Baseline: list shared behind a mutex.
+class LockedList {
+ public:
+  bool try_push(int value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    list_.push_back(value);
+    return true;
+  }
+  bool try_pop(int &value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (list_.empty()) {
+      return false;
+    }
+    value = list_.front();
+    list_.pop_front();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_ = std::mutex();
+  dizing::list<int> list_ = dizing::list<int>();
+};
+
+using Queue = dizing::mpmc_queue<int, kCapacity>;
+
+// Even threads produce, odd threads consume, every thread transfers one
+// element per iteration. Producers and consumers run the same number of
+// iterations, so the queue is empty after the run.
+template <typename Shared>
+void BM_MpmcTransfer(benchmark::State &state) {
+  static Shared queue;
+  bool producer = state.thread_index() % 2 == 0;
+  int value = 0;
+  for (auto _ : state) {
+    if (producer) {
+      while (!queue.try_push(++value)) {
+        std::this_thread::yield();
+      }
+    } else {
+      while (!queue.try_pop(value)) {
+        std::this_thread::yield();
+      }
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  SetItems(state, 1);
+}
+
+// Same with batches of kBatch elements per iteration.
+void BM_MpmcTransferBatch(benchmark::State &state) {
+  static Queue queue;
+  bool producer = state.thread_index() % 2 == 0;
+  int values[kBatch] = {};
+  for (auto _ : state) {
+    std::size_t done = 0;
+    while (done < kBatch) {
+      std::size_t count =
+          producer ? queue.try_push_batch(values + done, values + kBatch)
+                   : queue.try_pop_batch(values + done, kBatch - done);
+      if (count == 0) {
+        std::this_thread::yield();
+      }
+      done += count;
+    }
+    benchmark::DoNotOptimize(values);
+  }
+  SetItems(state, kBatch);
+}
+
+// From 1 producer/consumer pair up to one thread per hardware thread.
+void ThreadPairs(benchmark::internal::Benchmark *benchmark) {
+  int threads = static_cast<int>(
+      std::max(2u, std::thread::hardware_concurrency()));
+  for (int pairs = 1; 2 * pairs <= threads; pairs *= 2) {
+    benchmark->Threads(2 * pairs);
+  }
+  benchmark->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_MpmcTransfer, Queue)->Apply(ThreadPairs);
+BENCHMARK_TEMPLATE(BM_MpmcTransfer, LockedList)->Apply(ThreadPairs);
+BENCHMARK(BM_MpmcTransferBatch)->Apply(ThreadPairs);
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+constexpr std::size_t kElements = 1 << 22;
+
+dizing::vector<int> Shuffled() {
+  dizing::vector<int> values(kElements);
+  for (std::size_t i = 0; i < kElements; ++i) {
+    values[i] = static_cast<int>((i * 2654435761u) % kElements);
+  }
+  return values;
+}
+
+// Each benchmark runs on a pool of state.range(0) threads.
+
+void BM_ParallelForEach(benchmark::State &state) {
+  dizing::parallel::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  dizing::vector<int> values = Shuffled();
+  for (auto _ : state) {
+    dizing::parallel::for_each(pool, values.begin(), values.end(),
+                               [](int &value) { value = value * 3 + 1; });
+    benchmark::ClobberMemory();
+  }
+  SetItems(state, kElements);
+}
+
+void BM_ParallelTransform(benchmark::State &state) {
+  dizing::parallel::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  dizing::vector<int> values = Shuffled();
+  dizing::vector<double> out(kElements);
+  for (auto _ : state) {
+    dizing::parallel::transform(
+        pool, values.begin(), values.end(), out.begin(),
+        [](int value) { return static_cast<double>(value) * 0.5; });
+    benchmark::ClobberMemory();
+  }
+  SetItems(state, kElements);
+}
+
+void BM_ParallelReduce(benchmark::State &state) {
+  dizing::parallel::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  dizing::vector<int> values = Shuffled();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        dizing::parallel::reduce(pool, values.begin(), values.end(), 0L));
+  }
+  SetItems(state, kElements);
+}
+
+void BM_ParallelInclusiveScan(benchmark::State &state) {
+  dizing::parallel::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  dizing::vector<int> values = Shuffled();
+  dizing::vector<int> out(kElements);
+  for (auto _ : state) {
+    dizing::parallel::inclusive_scan(pool, values.begin(), values.end(),
+                                     out.begin());
+    benchmark::ClobberMemory();
+  }
+  SetItems(state, kElements);
+}
+
+void BM_ParallelSort(benchmark::State &state) {
+  dizing::parallel::thread_pool pool(static_cast<std::size_t>(state.range(0)));
+  dizing::vector<int> input = Shuffled();
+  dizing::vector<int> values;
+  for (auto _ : state) {
+    state.PauseTiming();
+    values = input;
+    state.ResumeTiming();
+    dizing::parallel::sort(pool, values.begin(), values.end());
+    benchmark::ClobberMemory();
+  }
+  SetItems(state, kElements);
+}
+
+// Baseline: sequential std::sort.
+void BM_StdSort(benchmark::State &state) {
+  dizing::vector<int> input = Shuffled();
+  dizing::vector<int> values;
+  for (auto _ : state) {
+    state.PauseTiming();
+    values = input;
+    state.ResumeTiming();
+    std::sort(values.begin(), values.end());
+    benchmark::ClobberMemory();
+  }
+  SetItems(state, kElements);
+}
+
+// Pools of 1 to 16 threads.
+void PoolSizes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK(BM_ParallelForEach)->Apply(PoolSizes);
+BENCHMARK(BM_ParallelTransform)->Apply(PoolSizes);
+BENCHMARK(BM_ParallelReduce)->Apply(PoolSizes);
+BENCHMARK(BM_ParallelInclusiveScan)->Apply(PoolSizes);
+BENCHMARK(BM_ParallelSort)->Apply(PoolSizes);
+BENCHMARK(BM_StdSort)->UseRealTime();
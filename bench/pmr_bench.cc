@@ -0,0 +1,71 @@
+#include <cstdint>
+#include <memory_resource>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+// Object graph of one request: range(0) lists of range(1) elements, built,
+// read once and torn down.
+template <typename Graph, typename Reclaim>
+void BuildGraph(benchmark::State &state, Graph graph, Reclaim reclaim) {
+  const auto lists = static_cast<std::size_t>(state.range(0));
+  const auto elements = static_cast<std::size_t>(state.range(1));
+  for (auto _ : state) {
+    {
+      auto requests = graph();
+      for (std::size_t i = 0; i < lists; ++i) {
+        auto &list = requests.emplace_back();
+        for (std::size_t j = 0; j < elements; ++j) {
+          list.push_back(static_cast<int>(i + j));
+        }
+      }
+      std::int64_t sum = 0;
+      for (const auto &list : requests) {
+        for (int value : list) {
+          sum += value;
+        }
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    reclaim();
+  }
+  SetItems(state, lists * elements);
+}
+
+void BM_RequestDefaultAllocator(benchmark::State &state) {
+  BuildGraph(
+      state, [] { return dizing::vector<dizing::list<int>>(); }, [] {});
+}
+
+// Arena is reset after every request and reused.
+void BM_RequestArena(benchmark::State &state) {
+  dizing::pmr::arena_resource arena;
+  BuildGraph(
+      state,
+      [&arena] { return dizing::pmr::vector<dizing::pmr::list<int>>(&arena); },
+      [&arena] { arena.reset(); });
+}
+
+// std::pmr::monotonic_buffer_resource returns memory upstream on release.
+void BM_RequestMonotonicBuffer(benchmark::State &state) {
+  std::pmr::monotonic_buffer_resource buffer;
+  BuildGraph(
+      state,
+      [&buffer] {
+        return dizing::pmr::vector<dizing::pmr::list<int>>(&buffer);
+      },
+      [&buffer] { buffer.release(); });
+}
+
+void GraphSizes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->Args({8, 8})->Args({64, 64})->Args({512, 64});
+}
+
+}  // namespace
+
+BENCHMARK(BM_RequestDefaultAllocator)->Apply(GraphSizes);
+BENCHMARK(BM_RequestArena)->Apply(GraphSizes);
+BENCHMARK(BM_RequestMonotonicBuffer)->Apply(GraphSizes);
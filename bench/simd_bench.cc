@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+// Benchmarks take the instruction set as the first argument and the size
+// as the second one; std is the baseline of each operation.
+constexpr int kStd = -1;
+
+template <typename T>
+dizing::vector<T> Telemetry(std::size_t size) {
+  dizing::vector<T> values(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    values[i] = static_cast<T>((i * 37 + 11) % 101);
+  }
+  return values;
+}
+
+// False and the benchmark skipped if the CPU lacks the instruction set.
+bool UseIsa(benchmark::State &state) {
+  if (state.range(0) == kStd) {
+    return true;
+  }
+  auto level = static_cast<dizing::simd::isa>(state.range(0));
+  if (!dizing::simd::set_active_isa(level)) {
+    state.SkipWithError("instruction set not supported");
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+void BM_SimdSum(benchmark::State &state) {
+  auto values = Telemetry<T>(static_cast<std::size_t>(state.range(1)));
+  if (!UseIsa(state)) {
+    return;
+  }
+  bool use_std = state.range(0) == kStd;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        use_std ? std::accumulate(values.begin(), values.end(), T())
+                : dizing::simd::sum(values));
+  }
+  SetItems(state, values.size());
+}
+
+template <typename T>
+void BM_SimdDot(benchmark::State &state) {
+  auto values = Telemetry<T>(static_cast<std::size_t>(state.range(1)));
+  if (!UseIsa(state)) {
+    return;
+  }
+  bool use_std = state.range(0) == kStd;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        use_std ? std::inner_product(values.begin(), values.end(),
+                                     values.begin(), T())
+                : dizing::simd::dot(values, values));
+  }
+  SetItems(state, values.size());
+}
+
+template <typename T>
+void BM_SimdMin(benchmark::State &state) {
+  auto values = Telemetry<T>(static_cast<std::size_t>(state.range(1)));
+  if (!UseIsa(state)) {
+    return;
+  }
+  bool use_std = state.range(0) == kStd;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        use_std ? *std::min_element(values.begin(), values.end())
+                : dizing::simd::min(values));
+  }
+  SetItems(state, values.size());
+}
+
+template <typename T>
+void BM_SimdCount(benchmark::State &state) {
+  auto values = Telemetry<T>(static_cast<std::size_t>(state.range(1)));
+  if (!UseIsa(state)) {
+    return;
+  }
+  bool use_std = state.range(0) == kStd;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        use_std ? static_cast<std::size_t>(
+                      std::count(values.begin(), values.end(), T(7)))
+                : dizing::simd::count(values, T(7)));
+  }
+  SetItems(state, values.size());
+}
+
+// The value is absent, so the whole range is scanned.
+template <typename T>
+void BM_SimdFind(benchmark::State &state) {
+  auto values = Telemetry<T>(static_cast<std::size_t>(state.range(1)));
+  if (!UseIsa(state)) {
+    return;
+  }
+  bool use_std = state.range(0) == kStd;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        use_std ? std::find(values.begin(), values.end(), T(120))
+                : dizing::simd::find(values, T(120)));
+  }
+  SetItems(state, values.size());
+}
+
+template <typename T>
+void BM_SimdEqual(benchmark::State &state) {
+  auto values = Telemetry<T>(static_cast<std::size_t>(state.range(1)));
+  auto copy = values;
+  if (!UseIsa(state)) {
+    return;
+  }
+  bool use_std = state.range(0) == kStd;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        use_std ? std::equal(values.begin(), values.end(), copy.begin())
+                : dizing::simd::equal(values, copy));
+  }
+  SetItems(state, values.size());
+}
+
+// std and every instruction set, on data in L1 and in L2 cache.
+void IsasAndSizes(benchmark::internal::Benchmark *benchmark) {
+  for (int size : {1 << 10, 1 << 16}) {
+    for (int level = kStd;
+         level <= static_cast<int>(dizing::simd::isa::avx512); ++level) {
+      benchmark->Args({level, size});
+    }
+  }
+  benchmark->ArgNames({"isa", "size"});
+}
+
+}  // namespace
+
+#define SIMD_BENCHMARKS(T)                                  \
+  BENCHMARK_TEMPLATE(BM_SimdSum, T)->Apply(IsasAndSizes);   \
+  BENCHMARK_TEMPLATE(BM_SimdDot, T)->Apply(IsasAndSizes);   \
+  BENCHMARK_TEMPLATE(BM_SimdMin, T)->Apply(IsasAndSizes);   \
+  BENCHMARK_TEMPLATE(BM_SimdCount, T)->Apply(IsasAndSizes); \
+  BENCHMARK_TEMPLATE(BM_SimdFind, T)->Apply(IsasAndSizes);  \
+  BENCHMARK_TEMPLATE(BM_SimdEqual, T)->Apply(IsasAndSizes)
+
+SIMD_BENCHMARKS(std::int8_t);
+SIMD_BENCHMARKS(std::int32_t);
+SIMD_BENCHMARKS(float);
+SIMD_BENCHMARKS(double);
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+// Containers of elements referred to by handles which stay valid while
+// other elements come and go: slot_map keys, hive and list iterators. A
+// vector has no such handles, elements are found by key.
+
+using SlotMap = dizing::slot_map<Pod64>;
+using Hive = dizing::hive<Pod64>;
+using List = dizing::list<Pod64>;
+using Vector = dizing::vector<Pod64>;
+
+dizing::slot_map_key Insert(SlotMap &map, const Pod64 &value) {
+  return map.insert(value);
+}
+void Erase(SlotMap &map, dizing::slot_map_key key) { map.erase(key); }
+
+Hive::iterator Insert(Hive &hive, const Pod64 &value) {
+  return hive.insert(value);
+}
+void Erase(Hive &hive, Hive::iterator it) { hive.erase(it); }
+
+List::iterator Insert(List &list, const Pod64 &value) {
+  list.push_back(value);
+  return std::prev(list.end());
+}
+void Erase(List &list, List::iterator it) { list.erase(it); }
+
+std::uint64_t Insert(Vector &vector, const Pod64 &value) {
+  vector.push_back(value);
+  return value.key;
+}
+void Erase(Vector &vector, std::uint64_t key) {
+  vector.erase(
+      std::find_if(vector.begin(), vector.end(),
+                   [&](const Pod64 &value) { return value.key == key; }));
+}
+
+template <typename Container>
+using Handle = decltype(Insert(std::declval<Container &>(), Pod64()));
+
+template <typename Container>
+std::vector<Handle<Container>> FillHandles(Container &container,
+                                           std::size_t count) {
+  std::vector<Handle<Container>> handles;
+  for (std::size_t i = 0; i < count; ++i) {
+    handles.push_back(Insert(container, MakeValue<Pod64>(i)));
+  }
+  return handles;
+}
+
+// Erases random elements of a container of range(0) elements and inserts
+// new ones in their place.
+constexpr std::size_t kChurnOperations = 1024;
+
+template <typename Container>
+void BM_Churn(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Container container;
+  auto handles = FillHandles(container, count);
+  const auto indices = RandomIndices(kChurnOperations);
+  std::size_t next = count;
+  for (auto _ : state) {
+    for (std::size_t index : indices) {
+      auto &handle = handles[index % count];
+      Erase(container, handle);
+      handle = Insert(container, MakeValue<Pod64>(next++));
+    }
+    benchmark::ClobberMemory();
+  }
+  SetItems(state, kChurnOperations);
+}
+
+// Iterates range(0) elements left of twice as many after erasing every
+// other element at random: hive skips the holes, list follows scattered
+// nodes, slot_map and vector stay dense.
+template <typename Container>
+void BM_IterateAfterErase(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  Container container;
+  auto handles = FillHandles(container, 2 * count);
+  const auto indices = RandomIndices(2 * count);
+  auto erased = [&](std::uint64_t key) { return indices[key] % 2 == 0; };
+  if constexpr (std::is_same_v<Container, Vector>) {
+    container.erase(std::remove_if(
+                        container.begin(), container.end(),
+                        [&](const Pod64 &value) { return erased(value.key); }),
+                    container.end());
+  } else {
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+      if (erased(i)) {
+        Erase(container, handles[i]);
+      }
+    }
+  }
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (const Pod64 &value : container) {
+      sum += value.key;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state, count);
+}
+
+}  // namespace
+
+#define STABLE_HANDLE_BENCHMARKS(func)                   \
+  BENCHMARK_TEMPLATE(func, SlotMap)->Apply(LinearSizes); \
+  BENCHMARK_TEMPLATE(func, Hive)->Apply(LinearSizes);    \
+  BENCHMARK_TEMPLATE(func, List)->Apply(LinearSizes);    \
+  BENCHMARK_TEMPLATE(func, Vector)->Apply(LinearSizes)
+
+STABLE_HANDLE_BENCHMARKS(BM_Churn);
+STABLE_HANDLE_BENCHMARKS(BM_IterateAfterErase);
@@ -0,0 +1,50 @@
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+template <typename T>
+using HeapVector = dizing::vector<T, dizing::counting_allocator<T>>;
+template <typename T>
+using StdVector = std::vector<T, dizing::counting_allocator<T>>;
+template <typename T>
+using SmallVector = dizing::small_vector<T, 8, dizing::counting_allocator<T>>;
+
+// Per-request vector: filled with a few elements, read once and dropped.
+template <typename Vector>
+void BM_ShortLived(benchmark::State &state) {
+  const auto count = static_cast<std::int64_t>(state.range(0));
+  dizing::operation_counts counts;
+  for (auto _ : state) {
+    Vector vec{typename Vector::allocator_type(counts)};
+    for (std::int64_t i = 0; i < count; ++i) {
+      vec.push_back(i);
+    }
+    std::int64_t sum = 0;
+    for (auto value : vec) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.counters["allocations_per_vector"] = benchmark::Counter(
+      static_cast<double>(counts.allocations),
+      benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ShortLived, HeapVector<std::int64_t>)
+    ->Arg(2)
+    ->Arg(8)
+    ->Arg(32);
+BENCHMARK_TEMPLATE(BM_ShortLived, StdVector<std::int64_t>)
+    ->Arg(2)
+    ->Arg(8)
+    ->Arg(32);
+BENCHMARK_TEMPLATE(BM_ShortLived, SmallVector<std::int64_t>)
+    ->Arg(2)
+    ->Arg(8)
+    ->Arg(32);
@@ -0,0 +1,133 @@
+#include <cstdint>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+// Telemetry row: scans read one or two of its fields.
+struct Event {
+  std::uint64_t id;
+  std::int64_t timestamp;
+  double value;
+  std::uint32_t flags;
+};
+
+using Events = dizing::soa_vector<std::uint64_t, std::int64_t, double,
+                                  std::uint32_t>;
+
+constexpr std::uint32_t kValid = 1;
+
+Event MakeEvent(std::size_t i) {
+  return {i, static_cast<std::int64_t>(i * 1000), static_cast<double>(i % 97),
+          static_cast<std::uint32_t>(i % 3 == 0 ? 0 : kValid)};
+}
+
+dizing::vector<Event> MakeRows(std::size_t size) {
+  dizing::vector<Event> rows;
+  rows.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    rows.push_back(MakeEvent(i));
+  }
+  return rows;
+}
+
+Events MakeColumns(std::size_t size) {
+  Events events;
+  events.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    Event event = MakeEvent(i);
+    events.emplace_back(event.id, event.timestamp, event.value, event.flags);
+  }
+  return events;
+}
+
+// Sum of one field.
+void BM_ScanOneField_Rows(benchmark::State &state) {
+  auto rows = MakeRows(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    double sum = 0;
+    for (const Event &event : rows) {
+      sum += event.value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state, rows.size());
+}
+
+void BM_ScanOneField_Columns(benchmark::State &state) {
+  auto events = MakeColumns(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    double sum = 0;
+    for (double value : events.column<2>()) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state, events.size());
+}
+
+void BM_ScanOneField_ColumnsSimd(benchmark::State &state) {
+  auto events = MakeColumns(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    dizing::span<const double> values = events.column<2>();
+    benchmark::DoNotOptimize(
+        dizing::simd::sum(values.begin(), values.end()));
+  }
+  SetItems(state, events.size());
+}
+
+// Sum of a field over rows selected by another one.
+void BM_ScanTwoFields_Rows(benchmark::State &state) {
+  auto rows = MakeRows(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    double sum = 0;
+    for (const Event &event : rows) {
+      sum += (event.flags & kValid) ? event.value : 0;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state, rows.size());
+}
+
+void BM_ScanTwoFields_Columns(benchmark::State &state) {
+  auto events = MakeColumns(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    dizing::span<const double> values = events.column<2>();
+    dizing::span<const std::uint32_t> flags = events.column<3>();
+    double sum = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      sum += (flags[i] & kValid) ? values[i] : 0;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state, events.size());
+}
+
+// Same through the row proxies of the zip iterator.
+void BM_ScanTwoFields_RowProxies(benchmark::State &state) {
+  auto events = MakeColumns(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    double sum = 0;
+    for (auto [id, timestamp, value, flags] : events) {
+      sum += (flags & kValid) ? value : 0;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state, events.size());
+}
+
+// From L2 resident to main memory.
+void ScanSizes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+}
+
+}  // namespace
+
+BENCHMARK(BM_ScanOneField_Rows)->Apply(ScanSizes);
+BENCHMARK(BM_ScanOneField_Columns)->Apply(ScanSizes);
+BENCHMARK(BM_ScanOneField_ColumnsSimd)->Apply(ScanSizes);
+BENCHMARK(BM_ScanTwoFields_Rows)->Apply(ScanSizes);
+BENCHMARK(BM_ScanTwoFields_Columns)->Apply(ScanSizes);
+BENCHMARK(BM_ScanTwoFields_RowProxies)->Apply(ScanSizes);
@@ -0,0 +1,174 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+constexpr std::size_t kMessageSize = 64;
+constexpr std::size_t kRingBytes = 1 << 16;
+// Messages in flight between the reader and the parser
+constexpr std::size_t kInFlight = 8;
+
+std::uint64_t NowNs() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+// Histogram of latencies in nanoseconds: four linear buckets per power of
+// two, so quantiles are exact within 25%.
+class LatencyHistogram {
+ public:
+  void Record(std::uint64_t ns) {
+    ++buckets_[Bucket(ns)];
+    ++count_;
+  }
+
+  // Upper bound of the bucket holding quantile q.
+  double Quantile(double q) const {
+    auto rank = static_cast<std::uint64_t>(q * static_cast<double>(count_));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+      seen += buckets_[i];
+      if (seen > rank) {
+        return static_cast<double>(UpperBound(i));
+      }
+    }
+    return 0;
+  }
+
+  void Report(benchmark::State &state) const {
+    state.counters["p50_ns"] = Quantile(0.5);
+    state.counters["p99_ns"] = Quantile(0.99);
+    state.counters["p999_ns"] = Quantile(0.999);
+  }
+
+ private:
+  std::array<std::uint64_t, 256> buckets_ = {};
+  std::uint64_t count_ = 0;
+
+  static std::size_t Bucket(std::uint64_t ns) {
+    if (ns < 4) {
+      return static_cast<std::size_t>(ns);
+    }
+    auto log = static_cast<std::size_t>(63 - __builtin_clzll(ns));
+    return 4 * (log - 1) + ((ns >> (log - 2)) & 3);
+  }
+  static std::uint64_t UpperBound(std::size_t bucket) {
+    if (bucket < 4) {
+      return bucket;
+    }
+    std::size_t log = bucket / 4 + 1;
+    std::uint64_t lower = (4 + bucket % 4) << (log - 2);
+    return lower + (std::uint64_t{1} << (log - 2)) - 1;
+  }
+};
+
+// Messages are written and read in place.
+class RingChannel {
+ public:
+  bool TrySend(std::uint64_t stamp) {
+    dizing::span<char> slots = ring_.reserve(kMessageSize);
+    if (slots.size() < kMessageSize) {
+      return false;
+    }
+    std::memset(slots.data(), 'm', kMessageSize);
+    std::memcpy(slots.data(), &stamp, sizeof(stamp));
+    ring_.commit(kMessageSize);
+    return true;
+  }
+  bool TryReceive(std::uint64_t &stamp) {
+    dizing::span<char> message = ring_.peek(kMessageSize);
+    if (message.size() < kMessageSize) {
+      return false;
+    }
+    std::memcpy(&stamp, message.data(), sizeof(stamp));
+    ring_.release(kMessageSize);
+    return true;
+  }
+
+ private:
+  dizing::spsc_ring<char, kRingBytes> ring_ =
+      dizing::spsc_ring<char, kRingBytes>();
+};
+
+// Baseline: every message is copied into a vector and passed through a
+// list behind a mutex.
+class LockedChannel {
+ public:
+  bool TrySend(std::uint64_t stamp) {
+    dizing::vector<char> message(kMessageSize, 'm');
+    std::memcpy(message.data(), &stamp, sizeof(stamp));
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_.push_back(std::move(message));
+    return true;
+  }
+  bool TryReceive(std::uint64_t &stamp) {
+    dizing::vector<char> message;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (messages_.empty()) {
+        return false;
+      }
+      message = std::move(messages_.front());
+      messages_.pop_front();
+    }
+    std::memcpy(&stamp, message.data(), sizeof(stamp));
+    return true;
+  }
+
+ private:
+  std::mutex mutex_ = std::mutex();
+  dizing::list<dizing::vector<char>> messages_ =
+      dizing::list<dizing::vector<char>>();
+};
+
+// One message per iteration from the benchmark thread to a parser thread,
+// latency is measured from send to receive.
+template <typename Channel>
+void BM_MessageLatency(benchmark::State &state) {
+  Channel channel;
+  LatencyHistogram histogram;
+  std::atomic<std::uint64_t> received(0);
+  std::atomic<bool> done(false);
+  std::thread parser([&] {
+    std::uint64_t stamp = 0;
+    while (!done.load(std::memory_order_acquire)) {
+      if (channel.TryReceive(stamp)) {
+        histogram.Record(NowNs() - stamp);
+        received.fetch_add(1, std::memory_order_release);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::uint64_t sent = 0;
+  for (auto _ : state) {
+    while (sent - received.load(std::memory_order_acquire) >= kInFlight ||
+           !channel.TrySend(NowNs())) {
+      std::this_thread::yield();
+    }
+    ++sent;
+  }
+  while (received.load(std::memory_order_acquire) < sent) {
+    std::this_thread::yield();
+  }
+  done.store(true, std::memory_order_release);
+  parser.join();
+  histogram.Report(state);
+  SetItems(state, 1);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_MessageLatency, RingChannel)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MessageLatency, LockedChannel)->UseRealTime();
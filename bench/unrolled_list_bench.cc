@@ -0,0 +1,31 @@
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+// Traversal of lists too large for the caches.
+void LargeSizes(benchmark::internal::Benchmark *benchmark) {
+  benchmark->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->Unit(
+      benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+// dizing::list counterparts of the sequence benchmarks are registered in
+// list_bench.cc under the same names.
+#define UNROLLED_LIST_BENCHMARK(func, sizes)                             \
+  BENCHMARK_TEMPLATE(func, dizing::unrolled_list<int>)->Apply(sizes);    \
+  BENCHMARK_TEMPLATE(func, dizing::unrolled_list<Pod64>)->Apply(sizes);  \
+  BENCHMARK_TEMPLATE(func, dizing::unrolled_list<Record>)->Apply(sizes)
+
+UNROLLED_LIST_BENCHMARK(BM_PushBack, LinearSizes);
+UNROLLED_LIST_BENCHMARK(BM_InsertFront, QuadraticSizes);
+UNROLLED_LIST_BENCHMARK(BM_InsertMiddle, QuadraticSizes);
+UNROLLED_LIST_BENCHMARK(BM_EraseFront, QuadraticSizes);
+UNROLLED_LIST_BENCHMARK(BM_EraseMiddle, QuadraticSizes);
+UNROLLED_LIST_BENCHMARK(BM_Iterate, LinearSizes);
+UNROLLED_LIST_BENCHMARK(BM_Copy, LinearSizes);
+
+BENCHMARK_TEMPLATE(BM_Iterate, dizing::list<int>)->Apply(LargeSizes);
+BENCHMARK_TEMPLATE(BM_Iterate, dizing::unrolled_list<int>)->Apply(LargeSizes);
@@ -0,0 +1,60 @@
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "benchmark/benchmark.h"
+#include "containers.h"
+
+namespace {
+
+// Row of several strings built from raw fields.
+struct Row {
+  std::string name;
+  std::string email;
+  std::string address;
+  Row(const char *name, const char *email, const char *address)
+      : name(name), email(email), address(address) {}
+};
+
+constexpr const char *kName = "a name that does not fit into sso buffer";
+constexpr const char *kEmail = "an.email.address@that-is-long-enough.com";
+constexpr const char *kAddress = "221B Baker Street, London, United Kingdom";
+
+template <typename Vector>
+void BM_PushBackTemporaryRow(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    Vector vec;
+    vec.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      vec.push_back(Row(kName, kEmail, kAddress));
+    }
+    benchmark::DoNotOptimize(vec.data());
+  }
+  SetItems(state, count);
+}
+
+template <typename Vector>
+void BM_EmplaceBackRow(benchmark::State &state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    Vector vec;
+    vec.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      vec.emplace_back(kName, kEmail, kAddress);
+    }
+    benchmark::DoNotOptimize(vec.data());
+  }
+  SetItems(state, count);
+}
+
+}  // namespace
+
+SEQUENCE_BENCHMARKS_VS_STD(vector);
+
+BENCHMARK_TEMPLATE(BM_PushBackTemporaryRow, dizing::vector<Row>)
+    ->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_EmplaceBackRow, dizing::vector<Row>)
+    ->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_EmplaceBackRow, std::vector<Row>)
+    ->Range(1 << 10, 1 << 16);
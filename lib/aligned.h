@@ -0,0 +1,163 @@
+#if !defined(CONTAINERS_LIB_ALIGNED_H)
+#define CONTAINERS_LIB_ALIGNED_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "array.h"
+#include "vector.h"
+
+namespace dizing {
+
+// Assumed size of a cache line, the default alignment of padded storage.
+inline constexpr std::size_t cache_line_size = 64;
+
+namespace aligned_internal {
+
+template <typename T, std::size_t Alignment>
+inline constexpr bool kValidAlignment =
+    Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0;
+
+}  // namespace aligned_internal
+
+// Allocator of arrays aligned to Alignment bytes, e.g. for vector buffers
+// read by SIMD kernels: vector<float, aligned_allocator<float, 32>>.
+// Stateless, all instances are equal.
+template <typename T, std::size_t Alignment = cache_line_size>
+class aligned_allocator {
+  static_assert(aligned_internal::kValidAlignment<T, Alignment>,
+                "alignment must be a power of two not below alignof(T)");
+
+ public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+  static constexpr std::size_t alignment = Alignment;
+
+  template <typename U>
+  struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() noexcept = default;
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Alignment> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    if (n > std::size_t(-1) / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T *pointer, std::size_t) noexcept {
+    ::operator delete(pointer, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(const aligned_allocator<U, Alignment> &) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const aligned_allocator<U, Alignment> &) const noexcept {
+    return false;
+  }
+};
+
+template <typename T, std::size_t Alignment = cache_line_size>
+using aligned_vector = vector<T, aligned_allocator<T, Alignment>>;
+
+// array whose elements start at a multiple of Alignment bytes. An aggregate
+// like array, which it is usable as.
+template <typename T, std::size_t N, std::size_t Alignment = cache_line_size>
+struct alignas(Alignment) aligned_array : array<T, N> {
+  static_assert(aligned_internal::kValidAlignment<T, Alignment>,
+                "alignment must be a power of two not below alignof(T)");
+};
+
+// Value alone on its cache line (or block of Alignment bytes): the size is
+// rounded up to the alignment, so neighbours in an array don't share lines
+// and writes by different threads don't invalidate each other's caches.
+template <typename T, std::size_t Alignment = cache_line_size>
+struct alignas(Alignment) padded {
+  static_assert(aligned_internal::kValidAlignment<T, Alignment>,
+                "alignment must be a power of two not below alignof(T)");
+
+  T value;
+
+  constexpr T &operator*() noexcept { return value; }
+  constexpr const T &operator*() const noexcept { return value; }
+  constexpr T *operator->() noexcept { return &value; }
+  constexpr const T *operator->() const noexcept { return &value; }
+};
+
+// One padded element per hardware thread, for per-thread state such as
+// counters which are combined afterwards. local() is the element of the
+// calling thread: threads get consecutive indices on first use, wrapping
+// around, so more threads than elements share elements and T must then be
+// safe to share, e.g. an atomic.
+template <typename T, std::size_t Alignment = cache_line_size>
+class per_core_array {
+ public:
+  using value_type = padded<T, Alignment>;
+  using size_type = std::size_t;
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+
+  per_core_array()
+      : per_core_array(std::max(1u, std::thread::hardware_concurrency())) {}
+  // Elements are value initialized.
+  explicit per_core_array(size_type size) : elements_(size) {
+    if (size == 0) {
+      throw std::length_error("per_core_array needs an element");
+    }
+  }
+
+  size_type size() const noexcept { return elements_.size(); }
+
+  T &operator[](size_type pos) { return *elements_[pos]; }
+  const T &operator[](size_type pos) const { return *elements_[pos]; }
+  T &local() { return (*this)[ThreadIndex() % size()]; }
+  const T &local() const { return (*this)[ThreadIndex() % size()]; }
+
+  // Iterators over the padded elements.
+  iterator begin() noexcept { return elements_.begin(); }
+  const_iterator begin() const noexcept { return elements_.begin(); }
+  iterator end() noexcept { return elements_.end(); }
+  const_iterator end() const noexcept { return elements_.end(); }
+
+ private:
+  vector<value_type, aligned_allocator<value_type, Alignment>> elements_;
+
+  static size_type ThreadIndex() noexcept {
+    static std::atomic<size_type> next_thread(0);
+    thread_local size_type index =
+        next_thread.fetch_add(1, std::memory_order_relaxed);
+    return index;
+  }
+};
+
+}  // namespace dizing
+
+namespace std {
+
+template <typename T, std::size_t N, std::size_t Alignment>
+struct tuple_size<dizing::aligned_array<T, N, Alignment>>
+    : std::integral_constant<std::size_t, N> {};
+
+template <std::size_t I, typename T, std::size_t N, std::size_t Alignment>
+struct tuple_element<I, dizing::aligned_array<T, N, Alignment>> {
+  static_assert(I < N, "index out of bounds");
+  using type = T;
+};
+
+}  // namespace std
+
+#endif  // CONTAINERS_LIB_ALIGNED_H
@@ -1,9 +1,32 @@
 #if !defined(CONTAINERS_LIB_ARRAY_H)
 #define CONTAINERS_LIB_ARRAY_H
+#include <cstddef>
+#include <functional>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace dizing {
 
+namespace array_internal {
+
+// std::swap is constexpr only since C++20: trivially copyable elements are
+// swapped by hand so tables can be built in constant expressions.
+template <typename T>
+constexpr void Swap(T &lhs, T &rhs) noexcept(
+    std::is_nothrow_swappable_v<T>) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    T temp = lhs;
+    lhs = rhs;
+    rhs = temp;
+  } else {
+    using std::swap;
+    swap(lhs, rhs);
+  }
+}
+
+}  // namespace array_internal
+
 // Helper structs.
 template <typename T, std::size_t size_>
 struct array_traits {
@@ -82,7 +105,9 @@ class array {
     return (pos < size_) ? helper::get_ref(arr_, pos)
                          : throw std::out_of_range("Position out of range");
   }
+  constexpr reference front() { return helper::get_ref(arr_); }
   constexpr const_reference front() const { return helper::get_ref(arr_); }
+  constexpr reference back() { return helper::get_ref(arr_, size_ - 1); }
   constexpr const_reference back() const {
     return helper::get_ref(arr_, size_ - 1);
   }
@@ -95,13 +120,180 @@ class array {
   constexpr bool empty() const noexcept { return size_ == 0; }
 
   // Modifiers
-  void swap(array &other) {
+  // Loops instead of std::fill and std::swap_ranges, which aren't constexpr
+  // in C++17.
+  constexpr void swap(array &other) noexcept(
+      std::is_nothrow_swappable_v<value_type>) {
     static_assert(std::is_swappable_v<value_type>);
-    std::swap_ranges(begin(), end(), other.begin());
+    for (iterator it = begin(), other_it = other.begin(); it != end();
+         ++it, ++other_it) {
+      array_internal::Swap(*it, *other_it);
+    }
+  }
+  constexpr void fill(const_reference value) {
+    for (iterator it = begin(); it != end(); ++it) {
+      *it = value;
+    }
   }
-  void fill(const_reference value) { std::fill(begin(), end(), value); }
 };
 
+// Comparisons
+template <typename T, std::size_t N>
+constexpr bool operator==(const array<T, N> &lhs, const array<T, N> &rhs) {
+  for (auto left = lhs.begin(), right = rhs.begin(); left != lhs.end();
+       ++left, ++right) {
+    if (!(*left == *right)) {
+      return false;
+    }
+  }
+  return true;
+}
+template <typename T, std::size_t N>
+constexpr bool operator!=(const array<T, N> &lhs, const array<T, N> &rhs) {
+  return !(lhs == rhs);
+}
+// Lexicographical
+template <typename T, std::size_t N>
+constexpr bool operator<(const array<T, N> &lhs, const array<T, N> &rhs) {
+  for (auto left = lhs.begin(), right = rhs.begin(); left != lhs.end();
+       ++left, ++right) {
+    if (*left < *right) {
+      return true;
+    }
+    if (*right < *left) {
+      return false;
+    }
+  }
+  return false;
+}
+template <typename T, std::size_t N>
+constexpr bool operator>(const array<T, N> &lhs, const array<T, N> &rhs) {
+  return rhs < lhs;
+}
+template <typename T, std::size_t N>
+constexpr bool operator<=(const array<T, N> &lhs, const array<T, N> &rhs) {
+  return !(rhs < lhs);
+}
+template <typename T, std::size_t N>
+constexpr bool operator>=(const array<T, N> &lhs, const array<T, N> &rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename T, std::size_t N>
+constexpr void swap(array<T, N> &lhs,
+                    array<T, N> &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+// Tuple protocol, for structured bindings
+template <std::size_t I, typename T, std::size_t N>
+constexpr T &get(array<T, N> &values) noexcept {
+  static_assert(I < N, "index out of bounds");
+  return values.arr_[I];
+}
+template <std::size_t I, typename T, std::size_t N>
+constexpr const T &get(const array<T, N> &values) noexcept {
+  static_assert(I < N, "index out of bounds");
+  return values.arr_[I];
+}
+template <std::size_t I, typename T, std::size_t N>
+constexpr T &&get(array<T, N> &&values) noexcept {
+  static_assert(I < N, "index out of bounds");
+  return std::move(values.arr_[I]);
+}
+template <std::size_t I, typename T, std::size_t N>
+constexpr const T &&get(const array<T, N> &&values) noexcept {
+  static_assert(I < N, "index out of bounds");
+  return std::move(values.arr_[I]);
+}
+
+namespace array_internal {
+
+template <typename T, std::size_t N, std::size_t... I>
+constexpr array<std::remove_cv_t<T>, N> ToArray(T (&values)[N],
+                                                std::index_sequence<I...>) {
+  return {{values[I]...}};
+}
+template <typename T, std::size_t N, std::size_t... I>
+constexpr array<std::remove_cv_t<T>, N> ToArray(T (&&values)[N],
+                                                std::index_sequence<I...>) {
+  return {{std::move(values[I])...}};
+}
+
+// Restores the heap order of the subtree at root within the first size
+// elements.
+template <typename Iter, typename Compare>
+constexpr void SiftDown(Iter first, std::ptrdiff_t root, std::ptrdiff_t size,
+                        Compare &comp) {
+  while (2 * root + 1 < size) {
+    std::ptrdiff_t child = 2 * root + 1;
+    if (child + 1 < size && comp(first[child], first[child + 1])) {
+      ++child;
+    }
+    if (!comp(first[root], first[child])) {
+      return;
+    }
+    Swap(first[root], first[child]);
+    root = child;
+  }
+}
+
+}  // namespace array_internal
+
+// Array with copies of the elements of a built-in array, e.g.
+// to_array("abc") or to_array<long>({1, 2}).
+template <typename T, std::size_t N>
+constexpr array<std::remove_cv_t<T>, N> to_array(T (&values)[N]) {
+  return array_internal::ToArray(values, std::make_index_sequence<N>());
+}
+template <typename T, std::size_t N>
+constexpr array<std::remove_cv_t<T>, N> to_array(T (&&values)[N]) {
+  return array_internal::ToArray(std::move(values),
+                                 std::make_index_sequence<N>());
+}
+
+// Algorithms usable in constant expressions, since most of <algorithm>
+// isn't constexpr in C++17.
+
+// Heapsort: O(n log n) without recursion, not stable.
+template <typename Iter, typename Compare = std::less<>>
+constexpr void constexpr_sort(Iter first, Iter last,
+                              Compare comp = Compare()) {
+  std::ptrdiff_t size = last - first;
+  for (std::ptrdiff_t root = size / 2; root-- > 0;) {
+    array_internal::SiftDown(first, root, size, comp);
+  }
+  while (size > 1) {
+    --size;
+    array_internal::Swap(first[0], first[size]);
+    array_internal::SiftDown(first, 0, size, comp);
+  }
+}
+
+// First element of the sorted range not less than value.
+template <typename Iter, typename T, typename Compare = std::less<>>
+constexpr Iter constexpr_lower_bound(Iter first, Iter last, const T &value,
+                                     Compare comp = Compare()) {
+  std::ptrdiff_t count = last - first;
+  while (count > 0) {
+    std::ptrdiff_t half = count / 2;
+    if (comp(first[half], value)) {
+      first += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+  return first;
+}
+
+template <typename Iter, typename T, typename Compare = std::less<>>
+constexpr bool constexpr_binary_search(Iter first, Iter last, const T &value,
+                                       Compare comp = Compare()) {
+  first = constexpr_lower_bound(first, last, value, comp);
+  return first != last && !comp(value, *first);
+}
+
 // Type deduction (Class template user-defined deduction guide)
 // For example guide array = {1, 2} to array<int, 2> = {1, 2}
 template <typename T, typename... Targs>
@@ -109,4 +301,18 @@ array(T, Targs...) -> array<T, sizeof...(Targs) + 1>;
 
 }  // namespace dizing
 
+namespace std {
+
+template <typename T, std::size_t N>
+struct tuple_size<dizing::array<T, N>>
+    : std::integral_constant<std::size_t, N> {};
+
+template <std::size_t I, typename T, std::size_t N>
+struct tuple_element<I, dizing::array<T, N>> {
+  static_assert(I < N, "index out of bounds");
+  using type = T;
+};
+
+}  // namespace std
+
 #endif  // CONTAINERS_LIB_ARRAY_H
\ No newline at end of file
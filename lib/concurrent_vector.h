@@ -0,0 +1,342 @@
+#if !defined(CONTAINERS_LIB_CONCURRENT_VECTOR_H)
+#define CONTAINERS_LIB_CONCURRENT_VECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "array.h"
+
+namespace dizing {
+
+namespace concurrent_vector_internal {
+
+// Element storage and a flag set once the element is constructed.
+template <typename T>
+struct Slot {
+  alignas(T) unsigned char storage[sizeof(T)];
+  std::atomic<bool> ready;
+
+  T *Value() noexcept { return reinterpret_cast<T *>(storage); }
+};
+
+template <typename Vector, bool isConst>
+class ConcurrentVectorIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = typename Vector::value_type;
+  using reference =
+      typename std::conditional_t<isConst, const value_type &, value_type &>;
+  using pointer =
+      typename std::conditional_t<isConst, const value_type *, value_type *>;
+  using vector_pointer =
+      typename std::conditional_t<isConst, const Vector *, Vector *>;
+
+  ConcurrentVectorIterator() noexcept : vector_(nullptr), index_(0) {}
+  ConcurrentVectorIterator(vector_pointer vector, std::size_t index) noexcept
+      : vector_(vector), index_(index) {}
+
+  // Non const to const
+  template <
+      bool otherIsConst,
+      std::enable_if_t<isConst == true && otherIsConst == false, bool> = true>
+  ConcurrentVectorIterator(
+      const ConcurrentVectorIterator<Vector, otherIsConst> &other) noexcept
+      : vector_(other.GetVector()), index_(other.GetIndex()) {}
+
+  reference operator*() const { return (*vector_)[index_]; }
+  pointer operator->() const { return &**this; }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  ConcurrentVectorIterator &operator++() {
+    ++index_;
+    return *this;
+  }
+  ConcurrentVectorIterator operator++(int) {
+    ConcurrentVectorIterator temp(*this);
+    ++index_;
+    return temp;
+  }
+  ConcurrentVectorIterator &operator--() {
+    --index_;
+    return *this;
+  }
+  ConcurrentVectorIterator operator--(int) {
+    ConcurrentVectorIterator temp(*this);
+    --index_;
+    return temp;
+  }
+  ConcurrentVectorIterator &operator+=(difference_type n) {
+    index_ =
+        static_cast<std::size_t>(static_cast<difference_type>(index_) + n);
+    return *this;
+  }
+  ConcurrentVectorIterator &operator-=(difference_type n) {
+    return *this += -n;
+  }
+  ConcurrentVectorIterator operator+(difference_type n) const {
+    ConcurrentVectorIterator temp(*this);
+    return temp += n;
+  }
+  friend ConcurrentVectorIterator operator+(
+      difference_type n, const ConcurrentVectorIterator &it) {
+    return it + n;
+  }
+  ConcurrentVectorIterator operator-(difference_type n) const {
+    ConcurrentVectorIterator temp(*this);
+    return temp -= n;
+  }
+  difference_type operator-(const ConcurrentVectorIterator &other) const {
+    return static_cast<difference_type>(index_) -
+           static_cast<difference_type>(other.index_);
+  }
+
+  bool operator==(const ConcurrentVectorIterator &other) const {
+    return index_ == other.index_;
+  }
+  bool operator!=(const ConcurrentVectorIterator &other) const {
+    return !(*this == other);
+  }
+  bool operator<(const ConcurrentVectorIterator &other) const {
+    return index_ < other.index_;
+  }
+  bool operator>(const ConcurrentVectorIterator &other) const {
+    return other < *this;
+  }
+  bool operator<=(const ConcurrentVectorIterator &other) const {
+    return !(other < *this);
+  }
+  bool operator>=(const ConcurrentVectorIterator &other) const {
+    return !(*this < other);
+  }
+
+  vector_pointer GetVector() const noexcept { return vector_; }
+  std::size_t GetIndex() const noexcept { return index_; }
+
+ private:
+  vector_pointer vector_;
+  std::size_t index_;
+};
+
+}  // namespace concurrent_vector_internal
+
+// Vector appended to concurrently. Storage is a table of segments of
+// kFirstSegment, 2 * kFirstSegment, 4 * kFirstSegment, ... elements which
+// are never relocated, so references stay valid for the life of the vector.
+// push_back first makes sure the segment of the next free index exists
+// (racing allocations are resolved by CAS), then claims that index by CAS,
+// retrying if another thread took it. Allocating before claiming means a
+// claimed index never points into a missing segment, so a failed
+// allocation can't leave a slot that never becomes ready. The element is
+// then constructed and marked ready. Readers see the committed prefix:
+// elements up to the first one still under construction.
+// Construction after claiming must not throw, throwing arguments are
+// converted to T first. Elements can't be removed.
+template <typename T, typename Allocator = std::allocator<T>>
+class concurrent_vector {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "elements must be nothrow movable");
+
+ public:
+  using value_type = T;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using iterator = concurrent_vector_internal::ConcurrentVectorIterator<
+      concurrent_vector, false>;
+  using const_iterator = concurrent_vector_internal::ConcurrentVectorIterator<
+      concurrent_vector, true>;
+  using value_traits = std::allocator_traits<Allocator>;
+  using slot = concurrent_vector_internal::Slot<T>;
+  using slot_alloc = typename value_traits::template rebind_alloc<slot>;
+  using slot_traits = typename value_traits::template rebind_traits<slot>;
+
+  static constexpr size_type kFirstSegmentLog = 4;
+  static constexpr size_type kFirstSegment = size_type(1) << kFirstSegmentLog;
+
+  concurrent_vector() : concurrent_vector(Allocator()) {}
+  explicit concurrent_vector(const Allocator &alloc)
+      : val_alloc_(alloc),
+        slot_alloc_(alloc),
+        claimed_(0),
+        committed_(0),
+        segments_() {}
+  concurrent_vector(const concurrent_vector &) = delete;
+  concurrent_vector &operator=(const concurrent_vector &) = delete;
+
+  // No other thread may use the vector.
+  ~concurrent_vector() {
+    for (size_type k = 0; k < kMaxSegments; ++k) {
+      slot *segment = segments_[k].load(std::memory_order_relaxed);
+      if (segment != nullptr) {
+        for (size_type i = 0; i < SegmentSize(k); ++i) {
+          if (segment[i].ready.load(std::memory_order_relaxed)) {
+            value_traits::destroy(val_alloc_, segment[i].Value());
+          }
+        }
+        slot_traits::deallocate(slot_alloc_, segment, SegmentSize(k));
+      }
+    }
+  }
+
+  Allocator get_allocator() const { return val_alloc_; }
+
+  // Element Access
+  // pos must be less than a size() seen by this thread, or the index of an
+  // element it appended.
+  reference operator[](size_type pos) { return *SlotAt(pos).Value(); }
+  const_reference operator[](size_type pos) const {
+    return *SlotAt(pos).Value();
+  }
+  reference at(size_type pos) {
+    CheckPosition(pos);
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    CheckPosition(pos);
+    return (*this)[pos];
+  }
+
+  // Iterators over the committed prefix at the moment of end().
+  iterator begin() noexcept { return iterator(this, 0); }
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  iterator end() noexcept { return iterator(this, size()); }
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+  const_iterator cend() const noexcept { return end(); }
+
+  // Capacity
+
+  // Length of the committed prefix; advances the shared committed count
+  // past elements constructed since.
+  size_type size() const noexcept {
+    size_type committed = committed_.load(std::memory_order_acquire);
+    size_type claimed = claimed_.load(std::memory_order_relaxed);
+    size_type count = committed;
+    while (count < claimed && IsReady(count)) {
+      ++count;
+    }
+    while (committed < count &&
+           !committed_.compare_exchange_weak(committed, count,
+                                             std::memory_order_release,
+                                             std::memory_order_acquire)) {
+    }
+    return count;
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  // Allocates segments for count elements, so appends up to count don't
+  // allocate. Safe to call concurrently with appends.
+  void reserve(size_type count) {
+    for (size_type k = 0; k < kMaxSegments && SegmentStart(k) < count; ++k) {
+      Segment(k);
+    }
+  }
+
+  // Modifiers
+  reference push_back(const_reference value) { return emplace_back(value); }
+  reference push_back(value_type &&value) {
+    return emplace_back(std::move(value));
+  }
+
+  // Lock-free if the segment of the element is allocated, see reserve().
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if constexpr (std::is_nothrow_constructible_v<T, Args &&...>) {
+      size_type index = claimed_.load(std::memory_order_relaxed);
+      slot *slots = nullptr;
+      do {
+        slots = Segment(Locate(index).first);
+      } while (!claimed_.compare_exchange_weak(index, index + 1,
+                                               std::memory_order_relaxed,
+                                               std::memory_order_relaxed));
+      slot &target = slots[Locate(index).second];
+      value_traits::construct(val_alloc_, target.Value(),
+                              std::forward<Args>(args)...);
+      target.ready.store(true, std::memory_order_release);
+      return *target.Value();
+    } else {
+      return emplace_back(T(std::forward<Args>(args)...));
+    }
+  }
+
+ private:
+  static constexpr size_type kMaxSegments =
+      sizeof(size_type) * 8 - kFirstSegmentLog;
+
+  Allocator val_alloc_;
+  slot_alloc slot_alloc_;
+  std::atomic<size_type> claimed_;
+  mutable std::atomic<size_type> committed_;
+  array<std::atomic<slot *>, kMaxSegments> segments_;
+
+  static constexpr size_type SegmentSize(size_type segment) noexcept {
+    return kFirstSegment << segment;
+  }
+  static constexpr size_type SegmentStart(size_type segment) noexcept {
+    return SegmentSize(segment) - kFirstSegment;
+  }
+
+  // Segment and offset of element index: index + kFirstSegment has its
+  // highest bit at kFirstSegmentLog + segment.
+  static std::pair<size_type, size_type> Locate(size_type index) noexcept {
+    size_type biased = index + kFirstSegment;
+    auto high_bit = static_cast<size_type>(
+        sizeof(unsigned long long) * 8 - 1 -
+        static_cast<size_type>(__builtin_clzll(biased)));
+    return {high_bit - kFirstSegmentLog,
+            biased - (size_type(1) << high_bit)};
+  }
+
+  slot &SlotAt(size_type index) const noexcept {
+    auto [segment, offset] = Locate(index);
+    return segments_[segment].load(std::memory_order_acquire)[offset];
+  }
+
+  bool IsReady(size_type index) const noexcept {
+    auto [segment, offset] = Locate(index);
+    slot *slots = segments_[segment].load(std::memory_order_acquire);
+    return slots != nullptr &&
+           slots[offset].ready.load(std::memory_order_acquire);
+  }
+
+  // Allocated segment, the first thread to publish its allocation wins.
+  slot *Segment(size_type segment) {
+    slot *slots = segments_[segment].load(std::memory_order_acquire);
+    if (slots != nullptr) {
+      return slots;
+    }
+    size_type size = SegmentSize(segment);
+    slot *allocated = slot_traits::allocate(slot_alloc_, size);
+    for (size_type i = 0; i < size; ++i) {
+      slot_traits::construct(slot_alloc_, allocated + i);
+    }
+    if (segments_[segment].compare_exchange_strong(
+            slots, allocated, std::memory_order_acq_rel,
+            std::memory_order_acquire)) {
+      return allocated;
+    }
+    slot_traits::deallocate(slot_alloc_, allocated, size);
+    return slots;
+  }
+
+  void CheckPosition(size_type pos) const {
+    size_type count = size();
+    if (!(pos < count)) {
+      throw std::out_of_range(std::to_string(pos) + " not less than " +
+                              std::to_string(count));
+    }
+  }
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_CONCURRENT_VECTOR_H
@@ -1,8 +1,26 @@
 #if !defined(CONTAINERS_LIB_CONTAINERS_H)
 #define CONTAINERS_LIB_CONTAINERS_H
 
+#include "aligned.h"
 #include "array.h"
+#include "concurrent_vector.h"
+#include "deque.h"
+#include "growth_policy.h"
+#include "hive.h"
+#include "instrumentation.h"
+#include "intrusive_list.h"
 #include "list.h"
+#include "mpmc_queue.h"
+#include "parallel.h"
+#include "pmr.h"
+#include "pool_allocator.h"
+#include "simd.h"
+#include "slot_map.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "span.h"
+#include "spsc_ring.h"
+#include "unrolled_list.h"
 #include "vector.h"
 
 #endif  // CONTAINERS_LIB_CONTAINERS_H
\ No newline at end of file
@@ -0,0 +1,588 @@
+#if !defined(CONTAINERS_LIB_DEQUE_H)
+#define CONTAINERS_LIB_DEQUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace dizing {
+
+namespace deque_internal {
+
+// Elements per block: blocks of about 4 KiB, but at least 16 elements.
+// Power of two, so positions split into block and slot by shifts.
+template <typename T>
+constexpr std::size_t BlockSize() {
+  std::size_t size = 16;
+  while (size * 2 * sizeof(T) <= 4096) {
+    size *= 2;
+  }
+  return size;
+}
+
+// Position is an index into the virtual array of all map blocks, it stays
+// valid while the map isn't reallocated or recentered.
+template <typename T, bool isConst>
+class DequeIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using reference =
+      typename std::conditional_t<isConst, const value_type &, value_type &>;
+  using pointer =
+      typename std::conditional_t<isConst, const value_type *, value_type *>;
+  using map_pointer = T *const *;
+
+  static constexpr std::size_t kBlockSize = BlockSize<T>();
+
+  DequeIterator() noexcept : map_(nullptr), position_(0) {}
+  DequeIterator(map_pointer map, std::size_t position) noexcept
+      : map_(map), position_(position) {}
+
+  // Non const to const
+  template <
+      bool otherIsConst,
+      std::enable_if_t<isConst == true && otherIsConst == false, bool> = true>
+  DequeIterator(const DequeIterator<T, otherIsConst> &other) noexcept
+      : map_(other.Map()), position_(other.Position()) {}
+
+  reference operator*() const {
+    return map_[position_ / kBlockSize][position_ % kBlockSize];
+  }
+  pointer operator->() const { return &**this; }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  DequeIterator &operator++() {
+    ++position_;
+    return *this;
+  }
+  DequeIterator operator++(int) {
+    DequeIterator temp(*this);
+    ++position_;
+    return temp;
+  }
+  DequeIterator &operator--() {
+    --position_;
+    return *this;
+  }
+  DequeIterator operator--(int) {
+    DequeIterator temp(*this);
+    --position_;
+    return temp;
+  }
+  DequeIterator &operator+=(difference_type n) {
+    position_ = static_cast<std::size_t>(
+        static_cast<difference_type>(position_) + n);
+    return *this;
+  }
+  DequeIterator &operator-=(difference_type n) { return *this += -n; }
+  DequeIterator operator+(difference_type n) const {
+    DequeIterator temp(*this);
+    return temp += n;
+  }
+  friend DequeIterator operator+(difference_type n, const DequeIterator &it) {
+    return it + n;
+  }
+  DequeIterator operator-(difference_type n) const {
+    DequeIterator temp(*this);
+    return temp -= n;
+  }
+  difference_type operator-(const DequeIterator &other) const {
+    return static_cast<difference_type>(position_) -
+           static_cast<difference_type>(other.position_);
+  }
+
+  bool operator==(const DequeIterator &other) const {
+    return position_ == other.position_;
+  }
+  bool operator!=(const DequeIterator &other) const {
+    return !(*this == other);
+  }
+  bool operator<(const DequeIterator &other) const {
+    return position_ < other.position_;
+  }
+  bool operator>(const DequeIterator &other) const { return other < *this; }
+  bool operator<=(const DequeIterator &other) const {
+    return !(other < *this);
+  }
+  bool operator>=(const DequeIterator &other) const {
+    return !(*this < other);
+  }
+
+  map_pointer Map() const noexcept { return map_; }
+  std::size_t Position() const noexcept { return position_; }
+
+ private:
+  map_pointer map_;
+  std::size_t position_;
+};
+
+}  // namespace deque_internal
+
+// Double-ended queue: a map of pointers to fixed size blocks.
+// push/pop at both ends are O(1) amortized and never move elements, so
+// references stay valid on insertion at the ends (iterators don't).
+// A block emptied by pop is kept as a spare for the next new block, so
+// queue-like usage reaches a steady state without allocations.
+template <typename T, typename Allocator = std::allocator<T>>
+class deque {
+ public:
+  using value_type = T;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using iterator = deque_internal::DequeIterator<value_type, false>;
+  using const_iterator = deque_internal::DequeIterator<value_type, true>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using map_alloc = typename alloc_traits::template rebind_alloc<pointer>;
+  using map_traits = typename alloc_traits::template rebind_traits<pointer>;
+
+  static constexpr size_type kBlockSize = iterator::kBlockSize;
+
+  // Constructors
+
+  deque() : deque(Allocator()) {}
+
+  explicit deque(const Allocator &alloc) noexcept
+      : map_(nullptr),
+        map_capacity_(0),
+        start_(0),
+        size_(0),
+        spare_(nullptr),
+        alloc_(alloc) {}
+
+  // Delegating constructors: once deque(alloc) is done, the destructor frees
+  // already created elements if the rest throws.
+  explicit deque(size_type count, const Allocator &alloc = Allocator())
+      : deque(alloc) {
+    resize(count);
+  }
+
+  deque(size_type count, const_reference value,
+        const Allocator &alloc = Allocator())
+      : deque(alloc) {
+    resize(count, value);
+  }
+
+  template <typename Iter,
+            typename = typename std::iterator_traits<Iter>::iterator_category>
+  deque(Iter first, Iter last, const Allocator &alloc = Allocator())
+      : deque(alloc) {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  deque(std::initializer_list<value_type> items,
+        const Allocator &alloc = Allocator())
+      : deque(items.begin(), items.end(), alloc) {}
+
+  deque(const deque &other)
+      : deque(other, alloc_traits::select_on_container_copy_construction(
+                         other.alloc_)) {}
+
+  deque(const deque &other, const Allocator &alloc)
+      : deque(other.begin(), other.end(), alloc) {}
+
+  // Steals the blocks, other is left empty.
+  deque(deque &&other) noexcept : deque(other.alloc_) { TakeStorage(other); }
+
+  // Steals the blocks if allocators are equal, otherwise elements are moved
+  // one by one.
+  deque(deque &&other, const Allocator &alloc) : deque(alloc) {
+    MoveElementsFrom(other);
+  }
+
+  ~deque() {
+    clear();
+    FreeStorage();
+  }
+
+  // The allocator of other is taken if it propagates on copy assignment.
+  deque &operator=(const deque &other) {
+    if (this != &other) {
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (alloc_ != other.alloc_) {
+          clear();
+          FreeStorage();
+        }
+        alloc_ = other.alloc_;
+      }
+      assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  // O(1) if the allocator propagates or both allocators are equal, otherwise
+  // elements are moved one by one.
+  deque &operator=(deque &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (this != &other) {
+      clear();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        FreeStorage();
+        alloc_ = other.alloc_;
+      }
+      MoveElementsFrom(other);
+    }
+    return *this;
+  }
+
+  template <typename Iter,
+            typename = typename std::iterator_traits<Iter>::iterator_category>
+  void assign(Iter first, Iter last) {
+    clear();
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  void assign(std::initializer_list<value_type> items) {
+    assign(items.begin(), items.end());
+  }
+
+  Allocator get_allocator() const { return alloc_; }
+
+  // Element Access
+  reference at(size_type pos) {
+    CheckPosition(pos);
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    CheckPosition(pos);
+    return (*this)[pos];
+  }
+  reference operator[](size_type pos) { return Element(start_ + pos); }
+  const_reference operator[](size_type pos) const {
+    return Element(start_ + pos);
+  }
+  reference front() { return Element(start_); }
+  const_reference front() const { return Element(start_); }
+  reference back() { return Element(start_ + size_ - 1); }
+  const_reference back() const { return Element(start_ + size_ - 1); }
+
+  // Iterators
+  iterator begin() noexcept { return iterator(map_, start_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(map_, start_);
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+  iterator end() noexcept { return iterator(map_, start_ + size_); }
+  const_iterator end() const noexcept {
+    return const_iterator(map_, start_ + size_);
+  }
+  const_iterator cend() const noexcept { return end(); }
+
+  // Capacity
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return alloc_traits::max_size(alloc_);
+  }
+  // Frees the spare block and the map of an empty deque.
+  void shrink_to_fit() {
+    if (spare_ != nullptr) {
+      alloc_traits::deallocate(alloc_, spare_, kBlockSize);
+      spare_ = nullptr;
+    }
+    if (size_ == 0) {
+      FreeStorage();
+    }
+  }
+
+  // Modifiers
+  void clear() noexcept {
+    while (size_ > 0) {
+      pop_back();
+    }
+    start_ = map_capacity_ / 2 * kBlockSize;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (start_ + size_ == map_capacity_ * kBlockSize) {
+      ReserveMap(false);
+    }
+    size_type position = start_ + size_;
+    bool new_block = AcquireBlock(position / kBlockSize);
+    try {
+      alloc_traits::construct(alloc_, &Element(position),
+                              std::forward<Args>(args)...);
+    } catch (...) {
+      if (new_block) {
+        ReleaseBlock(position / kBlockSize);
+      }
+      throw;
+    }
+    ++size_;
+    return Element(position);
+  }
+
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    if (start_ == 0) {
+      ReserveMap(true);
+    }
+    size_type position = start_ - 1;
+    bool new_block = AcquireBlock(position / kBlockSize);
+    try {
+      alloc_traits::construct(alloc_, &Element(position),
+                              std::forward<Args>(args)...);
+    } catch (...) {
+      if (new_block) {
+        ReleaseBlock(position / kBlockSize);
+      }
+      throw;
+    }
+    --start_;
+    ++size_;
+    return Element(position);
+  }
+
+  void pop_back() noexcept {
+    --size_;
+    size_type position = start_ + size_;
+    alloc_traits::destroy(alloc_, &Element(position));
+    if (position % kBlockSize == 0 || size_ == 0) {
+      ReleaseBlock(position / kBlockSize);
+    }
+  }
+
+  void pop_front() noexcept {
+    size_type position = start_;
+    alloc_traits::destroy(alloc_, &Element(position));
+    ++start_;
+    --size_;
+    if (start_ % kBlockSize == 0 || size_ == 0) {
+      ReleaseBlock(position / kBlockSize);
+    }
+  }
+
+  // Inserts at the end closer to pos and rotates the element into place,
+  // O(min(distance to begin, distance to end)).
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    size_type index = IndexOf(pos);
+    if (index < size_ / 2) {
+      emplace_front(std::forward<Args>(args)...);
+      std::rotate(begin(), begin() + 1, begin() + Offset(index) + 1);
+    } else {
+      emplace_back(std::forward<Args>(args)...);
+      std::rotate(begin() + Offset(index), end() - 1, end());
+    }
+    return begin() + Offset(index);
+  }
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  // Shifts the shorter side over the erased elements.
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type index = IndexOf(first);
+    size_type count = IndexOf(last) - index;
+    if (index < size_ - index - count) {
+      std::move_backward(begin(), begin() + Offset(index),
+                         begin() + Offset(index + count));
+      for (size_type i = 0; i < count; ++i) {
+        pop_front();
+      }
+    } else {
+      std::move(begin() + Offset(index + count), end(),
+                begin() + Offset(index));
+      for (size_type i = 0; i < count; ++i) {
+        pop_back();
+      }
+    }
+    return begin() + Offset(index);
+  }
+
+  void resize(size_type count) {
+    while (size_ > count) {
+      pop_back();
+    }
+    while (size_ < count) {
+      emplace_back();
+    }
+  }
+  void resize(size_type count, const_reference value) {
+    while (size_ > count) {
+      pop_back();
+    }
+    while (size_ < count) {
+      emplace_back(value);
+    }
+  }
+
+  // Allocators are exchanged only if they propagate on swap, otherwise they
+  // must be equal.
+  void swap(deque &other) noexcept {
+    std::swap(map_, other.map_);
+    std::swap(map_capacity_, other.map_capacity_);
+    std::swap(start_, other.start_);
+    std::swap(size_, other.size_);
+    std::swap(spare_, other.spare_);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+  }
+
+ private:
+  // Map of map_capacity_ blocks, a block is allocated iff it holds elements.
+  // Elements occupy positions [start_, start_ + size_) of the virtual array
+  // of all blocks.
+  pointer *map_;
+  size_type map_capacity_;
+  size_type start_;
+  size_type size_;
+  pointer spare_;
+  Allocator alloc_;
+
+  reference Element(size_type position) const {
+    return map_[position / kBlockSize][position % kBlockSize];
+  }
+
+  size_type IndexOf(const_iterator pos) const {
+    return pos.Position() - start_;
+  }
+
+  static difference_type Offset(size_type index) {
+    return static_cast<difference_type>(index);
+  }
+
+  void CheckPosition(size_type pos) const {
+    if (!(pos < size_)) {
+      throw std::out_of_range(std::to_string(pos) + " not less than " +
+                              std::to_string(size_));
+    }
+  }
+
+  // Allocates block of the map if it's missing, returns if it was.
+  bool AcquireBlock(size_type block) {
+    if (map_[block] != nullptr) {
+      return false;
+    }
+    if (spare_ != nullptr) {
+      map_[block] = spare_;
+      spare_ = nullptr;
+    } else {
+      map_[block] = alloc_traits::allocate(alloc_, kBlockSize);
+    }
+    return true;
+  }
+
+  void ReleaseBlock(size_type block) noexcept {
+    if (spare_ == nullptr) {
+      spare_ = map_[block];
+    } else {
+      alloc_traits::deallocate(alloc_, map_[block], kBlockSize);
+    }
+    map_[block] = nullptr;
+  }
+
+  // Makes room for one more block at the front or the back. Used blocks are
+  // centered in the map, which is reallocated only if it is at least half
+  // full. Blocks themselves never move.
+  void ReserveMap(bool at_front) {
+    size_type first_block = start_ / kBlockSize;
+    size_type used =
+        size_ == 0 ? 0 : (start_ + size_ - 1) / kBlockSize - first_block + 1;
+    size_type needed = used + 1;
+    size_type capacity = map_capacity_;
+    pointer *map = map_;
+    if (capacity < 2 * needed) {
+      capacity = std::max({size_type(8), 2 * map_capacity_, 2 * needed});
+      map_alloc allocator(alloc_);
+      map = map_traits::allocate(allocator, capacity);
+      std::fill(map, map + capacity, nullptr);
+    }
+    size_type new_first = (capacity - needed) / 2 + (at_front ? 1 : 0);
+    if (map == map_) {
+      if (new_first < first_block) {
+        std::copy(map_ + first_block, map_ + first_block + used,
+                  map_ + new_first);
+      } else {
+        std::copy_backward(map_ + first_block, map_ + first_block + used,
+                           map_ + new_first + used);
+      }
+      std::fill(map_, map_ + new_first, nullptr);
+      std::fill(map_ + new_first + used, map_ + capacity, nullptr);
+    } else {
+      if (map_ != nullptr) {
+        std::copy(map_ + first_block, map_ + first_block + used,
+                  map + new_first);
+        map_alloc allocator(alloc_);
+        map_traits::deallocate(allocator, map_, map_capacity_);
+      }
+      map_ = map;
+      map_capacity_ = capacity;
+    }
+    start_ = new_first * kBlockSize + start_ % kBlockSize;
+  }
+
+  // Frees the spare block and the map, deque must be empty.
+  void FreeStorage() noexcept {
+    if (spare_ != nullptr) {
+      alloc_traits::deallocate(alloc_, spare_, kBlockSize);
+      spare_ = nullptr;
+    }
+    if (map_ != nullptr) {
+      map_alloc allocator(alloc_);
+      map_traits::deallocate(allocator, map_, map_capacity_);
+      map_ = nullptr;
+    }
+    map_capacity_ = 0;
+    start_ = 0;
+  }
+
+  // Takes storage of other while this is empty without storage.
+  void TakeStorage(deque &other) noexcept {
+    map_ = std::exchange(other.map_, nullptr);
+    map_capacity_ = std::exchange(other.map_capacity_, 0);
+    start_ = std::exchange(other.start_, 0);
+    size_ = std::exchange(other.size_, 0);
+    spare_ = std::exchange(other.spare_, nullptr);
+  }
+
+  // Appends elements of other while this is empty, other becomes empty.
+  // Storage is stolen if allocators are equal, otherwise elements are moved
+  // one by one.
+  void MoveElementsFrom(deque &other) {
+    if (alloc_ == other.alloc_) {
+      FreeStorage();
+      TakeStorage(other);
+    } else {
+      for (auto &element : other) {
+        emplace_back(std::move(element));
+      }
+      other.clear();
+    }
+  }
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_DEQUE_H
@@ -0,0 +1,116 @@
+#if !defined(CONTAINERS_LIB_GROWTH_POLICY_H)
+#define CONTAINERS_LIB_GROWTH_POLICY_H
+
+#include <algorithm>
+#include <cstddef>
+
+namespace dizing {
+
+// Growth policies decide capacity of a reallocated buffer.
+// Policy must provide
+//   static std::size_t next_capacity(std::size_t capacity,
+//                                    std::size_t required,
+//                                    std::size_t element_size);
+// returning a capacity not less than required. It is called only when
+// capacity is exhausted. MinCapacity of built-in policies is the capacity of
+// the first allocation, so small containers skip 1 -> 2 -> 4 reallocations.
+
+namespace growth_internal {
+
+constexpr std::size_t Clamp(std::size_t grown, std::size_t required,
+                            std::size_t min_capacity) {
+  return std::max({grown, required, min_capacity});
+}
+
+// Multiplies capacity by Numerator / Denominator, at least by one element.
+template <std::size_t Numerator, std::size_t Denominator>
+constexpr std::size_t Scale(std::size_t capacity) {
+  static_assert(Numerator > Denominator, "Growth factor must exceed 1");
+  return std::max(capacity + 1, capacity / Denominator * Numerator +
+                                    capacity % Denominator * Numerator /
+                                        Denominator);
+}
+
+// Number of elements fitting into bytes rounded up by round_bytes.
+template <typename RoundBytes>
+constexpr std::size_t RoundCapacity(std::size_t capacity,
+                                    std::size_t element_size,
+                                    RoundBytes round_bytes) {
+  return round_bytes(capacity * element_size) / element_size;
+}
+
+}  // namespace growth_internal
+
+// Capacity grows by Numerator / Denominator.
+template <std::size_t Numerator, std::size_t Denominator,
+          std::size_t MinCapacity = 1>
+struct factor_growth {
+  static constexpr std::size_t next_capacity(std::size_t capacity,
+                                             std::size_t required,
+                                             std::size_t) {
+    return growth_internal::Clamp(
+        growth_internal::Scale<Numerator, Denominator>(capacity), required,
+        MinCapacity);
+  }
+};
+
+// 1 -> 2 -> 4 -> ..., the default policy.
+// Fewest reallocations, up to half of the buffer may stay unused.
+template <std::size_t MinCapacity = 1>
+struct doubling_growth : factor_growth<2, 1, MinCapacity> {};
+
+// Up to a third of the buffer may stay unused and freed blocks can be reused
+// by later reallocations of the same buffer.
+template <std::size_t MinCapacity = 1>
+struct one_and_half_growth : factor_growth<3, 2, MinCapacity> {};
+
+// Grows by 1.5 and rounds buffers of at least a page up to whole pages, so
+// large buffers don't leave partially used pages behind.
+template <std::size_t MinCapacity = 1, std::size_t PageSize = 4096>
+struct page_rounded_growth {
+  static constexpr std::size_t next_capacity(std::size_t capacity,
+                                             std::size_t required,
+                                             std::size_t element_size) {
+    std::size_t grown = growth_internal::Clamp(
+        growth_internal::Scale<3, 2>(capacity), required, MinCapacity);
+    if (grown * element_size < PageSize) {
+      return grown;
+    }
+    return growth_internal::RoundCapacity(
+        grown, element_size, [](std::size_t bytes) {
+          return (bytes + PageSize - 1) / PageSize * PageSize;
+        });
+  }
+};
+
+// Grows by 1.5 and rounds buffer up to the size class of malloc
+// implementations like jemalloc/tcmalloc: 16 byte steps up to 128 bytes,
+// then four classes per power of two. The slack malloc would waste anyway
+// becomes usable capacity.
+template <std::size_t MinCapacity = 1>
+struct size_class_growth {
+  static constexpr std::size_t RoundToSizeClass(std::size_t bytes) {
+    if (bytes <= 128) {
+      return (bytes + 15) / 16 * 16;
+    }
+    std::size_t power = 0;
+    for (std::size_t rest = bytes - 1; rest > 1; rest >>= 1) {
+      ++power;
+    }
+    std::size_t spacing = std::size_t(1) << (power - 2);
+    return (bytes + spacing - 1) / spacing * spacing;
+  }
+
+  static constexpr std::size_t next_capacity(std::size_t capacity,
+                                             std::size_t required,
+                                             std::size_t element_size) {
+    std::size_t grown = growth_internal::Clamp(
+        growth_internal::Scale<3, 2>(capacity), required, MinCapacity);
+    return growth_internal::RoundCapacity(grown, element_size,
+                                          RoundToSizeClass);
+  }
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_GROWTH_POLICY_H
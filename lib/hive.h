@@ -0,0 +1,546 @@
+#if !defined(CONTAINERS_LIB_HIVE_H)
+#define CONTAINERS_LIB_HIVE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace dizing {
+
+namespace hive_internal {
+
+inline constexpr std::uint16_t kNoRun = 0xFFFF;
+
+// Links of a run of erased slots, stored at the first slot of the run.
+struct FreeRun {
+  std::uint16_t prev;
+  std::uint16_t next;
+};
+
+// Block of capacity slots, of which [0, end) were ever used. skip is a
+// jump-counting skipfield: 0 for a live slot, and the length of the run of
+// erased slots at the first and the last slot of each run (other slots of
+// a run are non zero). skip[end] is always 0.
+template <typename T>
+struct HiveBlock {
+  T *elements;
+  std::uint16_t *skip;
+  FreeRun *runs;
+  std::size_t capacity;
+  std::size_t end;
+  std::size_t live;
+  // First run of the list of free runs, kNoRun if there are none
+  std::uint16_t free_head;
+  // Blocks of the hive in iteration order
+  HiveBlock *prev;
+  HiveBlock *next;
+  // Blocks with free runs
+  HiveBlock *prev_free;
+  HiveBlock *next_free;
+};
+
+// Bidirectional iterator, jumps over runs of erased slots in O(1).
+template <typename T, bool isConst>
+class HiveIterator {
+  using Block = HiveBlock<T>;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using reference = std::conditional_t<isConst, const T &, T &>;
+  using pointer = std::conditional_t<isConst, const T *, T *>;
+
+  HiveIterator() noexcept : block_(nullptr), index_(0) {}
+  HiveIterator(Block *block, std::size_t index) noexcept
+      : block_(block), index_(index) {}
+
+  // Non const to const
+  template <
+      bool otherIsConst,
+      std::enable_if_t<isConst == true && otherIsConst == false, bool> = true>
+  HiveIterator(const HiveIterator<T, otherIsConst> &other) noexcept
+      : block_(other.GetBlock()), index_(other.GetIndex()) {}
+
+  reference operator*() const { return block_->elements[index_]; }
+  pointer operator->() const { return block_->elements + index_; }
+
+  HiveIterator &operator++() {
+    ++index_;
+    index_ += block_->skip[index_];
+    if (index_ == block_->end && block_->next != nullptr) {
+      block_ = block_->next;
+      index_ = block_->skip[0];
+    }
+    return *this;
+  }
+  HiveIterator operator++(int) {
+    HiveIterator temp(*this);
+    ++*this;
+    return temp;
+  }
+  HiveIterator &operator--() {
+    std::size_t index = index_;
+    while (true) {
+      if (index == 0) {
+        block_ = block_->prev;
+        index = block_->end;
+      }
+      std::size_t skip = block_->skip[index - 1];
+      if (skip == 0) {
+        index_ = index - 1;
+        return *this;
+      }
+      // Start of the run, the slot before it is live or in the previous
+      // block
+      index -= skip;
+    }
+  }
+  HiveIterator operator--(int) {
+    HiveIterator temp(*this);
+    --*this;
+    return temp;
+  }
+
+  bool operator==(const HiveIterator &other) const {
+    return block_ == other.block_ && index_ == other.index_;
+  }
+  bool operator!=(const HiveIterator &other) const {
+    return !(*this == other);
+  }
+
+  Block *GetBlock() const noexcept { return block_; }
+  std::size_t GetIndex() const noexcept { return index_; }
+
+ private:
+  Block *block_;
+  std::size_t index_;
+};
+
+}  // namespace hive_internal
+
+// Unordered collection of blocks of elements which never moves elements:
+// pointers and iterators stay valid until their element is erased. Erase
+// marks the slot in a skipfield, iteration jumps over erased runs in O(1),
+// and insert reuses erased slots before appending to the last block, so
+// insert and erase are O(1). Blocks grow with the size up to
+// kMaxBlockCapacity and are freed once their last element is erased.
+template <typename T, typename Allocator = std::allocator<T>>
+class hive {
+  using Block = hive_internal::HiveBlock<T>;
+  using FreeRun = hive_internal::FreeRun;
+
+ public:
+  using value_type = T;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using iterator = hive_internal::HiveIterator<value_type, false>;
+  using const_iterator = hive_internal::HiveIterator<value_type, true>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  static constexpr size_type kMinBlockCapacity = 8;
+  static constexpr size_type kMaxBlockCapacity = 8192;
+
+  // Constructors
+
+  hive() : hive(Allocator()) {}
+
+  explicit hive(const Allocator &alloc) noexcept
+      : first_(nullptr),
+        last_(nullptr),
+        free_blocks_(nullptr),
+        size_(0),
+        capacity_(0),
+        alloc_(alloc) {}
+
+  template <typename Iter,
+            typename = typename std::iterator_traits<Iter>::iterator_category>
+  hive(Iter first, Iter last, const Allocator &alloc = Allocator())
+      : hive(alloc) {
+    for (; first != last; ++first) {
+      emplace(*first);
+    }
+  }
+
+  hive(std::initializer_list<value_type> items,
+       const Allocator &alloc = Allocator())
+      : hive(items.begin(), items.end(), alloc) {}
+
+  hive(const hive &other)
+      : hive(other, alloc_traits::select_on_container_copy_construction(
+                        other.alloc_)) {}
+
+  hive(const hive &other, const Allocator &alloc)
+      : hive(other.begin(), other.end(), alloc) {}
+
+  // Steals the blocks, other is left empty.
+  hive(hive &&other) noexcept : hive(other.alloc_) { TakeStorage(other); }
+
+  // Steals the blocks if allocators are equal, otherwise elements are moved
+  // one by one.
+  hive(hive &&other, const Allocator &alloc) : hive(alloc) {
+    MoveElementsFrom(other);
+  }
+
+  ~hive() { clear(); }
+
+  // The allocator of other is taken if it propagates on copy assignment.
+  hive &operator=(const hive &other) {
+    if (this != &other) {
+      clear();
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        alloc_ = other.alloc_;
+      }
+      for (const_reference value : other) {
+        emplace(value);
+      }
+    }
+    return *this;
+  }
+
+  // O(1) if the allocator propagates or both allocators are equal, otherwise
+  // elements are moved one by one.
+  hive &operator=(hive &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (this != &other) {
+      clear();
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = other.alloc_;
+      }
+      MoveElementsFrom(other);
+    }
+    return *this;
+  }
+
+  Allocator get_allocator() const { return alloc_; }
+
+  // Iterators, in block order and within blocks in slot order.
+  iterator begin() noexcept {
+    return first_ == nullptr ? iterator() : iterator(first_, first_->skip[0]);
+  }
+  const_iterator begin() const noexcept {
+    return const_cast<hive *>(this)->begin();
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+  iterator end() noexcept {
+    return last_ == nullptr ? iterator() : iterator(last_, last_->end);
+  }
+  const_iterator end() const noexcept {
+    return const_cast<hive *>(this)->end();
+  }
+  const_iterator cend() const noexcept { return end(); }
+
+  // Capacity
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  // Slots of all blocks.
+  size_type capacity() const noexcept { return capacity_; }
+
+  // Modifiers
+
+  iterator insert(const_reference value) { return emplace(value); }
+  iterator insert(value_type &&value) { return emplace(std::move(value)); }
+
+  // Invalidates end().
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    Block *block = free_blocks_;
+    size_type index = 0;
+    if (block != nullptr) {
+      index = block->free_head;
+      Construct(block, index, std::forward<Args>(args)...);
+      ReuseRunStart(block);
+    } else if (last_ != nullptr && last_->end < last_->capacity) {
+      block = last_;
+      index = block->end;
+      Construct(block, index, std::forward<Args>(args)...);
+      ++block->end;
+    } else {
+      block = NewBlock(std::clamp(size_, kMinBlockCapacity,
+                                  kMaxBlockCapacity));
+      try {
+        Construct(block, index, std::forward<Args>(args)...);
+      } catch (...) {
+        FreeBlock(block);
+        throw;
+      }
+      block->end = 1;
+      LinkBlock(block);
+    }
+    ++block->live;
+    ++size_;
+    return iterator(block, index);
+  }
+
+  // Returns the iterator following pos. Invalidates only iterators to the
+  // erased element and end().
+  iterator erase(const_iterator pos) {
+    Block *block = pos.GetBlock();
+    size_type index = pos.GetIndex();
+    iterator next(block, index);
+    ++next;
+    alloc_traits::destroy(alloc_, block->elements + index);
+    --size_;
+    if (--block->live == 0) {
+      if (block->free_head != hive_internal::kNoRun) {
+        UnlinkFreeBlock(block);
+      }
+      UnlinkBlock(block);
+      FreeBlock(block);
+      return next.GetBlock() == block ? end() : next;
+    }
+    EraseSlot(block, index);
+    return next;
+  }
+
+  void clear() noexcept {
+    while (first_ != nullptr) {
+      Block *block = first_;
+      first_ = block->next;
+      for (size_type index = block->skip[0]; index < block->end;
+           index += block->skip[index]) {
+        alloc_traits::destroy(alloc_, block->elements + index);
+        ++index;
+      }
+      FreeBlock(block);
+    }
+    last_ = nullptr;
+    free_blocks_ = nullptr;
+    size_ = 0;
+  }
+
+  // Allocators are exchanged only if they propagate on swap, otherwise they
+  // must be equal.
+  void swap(hive &other) noexcept {
+    std::swap(first_, other.first_);
+    std::swap(last_, other.last_);
+    std::swap(free_blocks_, other.free_blocks_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
+  }
+
+ private:
+  using block_alloc = typename alloc_traits::template rebind_alloc<Block>;
+  using block_traits = typename alloc_traits::template rebind_traits<Block>;
+  using skip_alloc =
+      typename alloc_traits::template rebind_alloc<std::uint16_t>;
+  using skip_traits =
+      typename alloc_traits::template rebind_traits<std::uint16_t>;
+  using run_alloc = typename alloc_traits::template rebind_alloc<FreeRun>;
+  using run_traits = typename alloc_traits::template rebind_traits<FreeRun>;
+
+  Block *first_;
+  Block *last_;
+  // List of blocks with free runs, through next_free
+  Block *free_blocks_;
+  size_type size_;
+  size_type capacity_;
+  Allocator alloc_;
+
+  template <typename... Args>
+  void Construct(Block *block, size_type index, Args &&...args) {
+    alloc_traits::construct(alloc_, block->elements + index,
+                            std::forward<Args>(args)...);
+  }
+
+  Block *NewBlock(size_type capacity) {
+    block_alloc blocks(alloc_);
+    skip_alloc skips(alloc_);
+    run_alloc runs(alloc_);
+    Block *block = block_traits::allocate(blocks, 1);
+    pointer elements = nullptr;
+    std::uint16_t *skip = nullptr;
+    try {
+      elements = alloc_traits::allocate(alloc_, capacity);
+      skip = skip_traits::allocate(skips, capacity + 1);
+      FreeRun *free_runs = run_traits::allocate(runs, capacity);
+      std::uninitialized_fill_n(skip, capacity + 1, std::uint16_t{0});
+      ::new (static_cast<void *>(block)) Block{
+          elements, skip, free_runs, capacity, 0, 0,
+          hive_internal::kNoRun, nullptr, nullptr, nullptr, nullptr};
+    } catch (...) {
+      if (skip != nullptr) {
+        skip_traits::deallocate(skips, skip, capacity + 1);
+      }
+      if (elements != nullptr) {
+        alloc_traits::deallocate(alloc_, elements, capacity);
+      }
+      block_traits::deallocate(blocks, block, 1);
+      throw;
+    }
+    capacity_ += capacity;
+    return block;
+  }
+
+  // Block must hold no elements.
+  void FreeBlock(Block *block) noexcept {
+    block_alloc blocks(alloc_);
+    skip_alloc skips(alloc_);
+    run_alloc runs(alloc_);
+    capacity_ -= block->capacity;
+    run_traits::deallocate(runs, block->runs, block->capacity);
+    skip_traits::deallocate(skips, block->skip, block->capacity + 1);
+    alloc_traits::deallocate(alloc_, block->elements, block->capacity);
+    block_traits::deallocate(blocks, block, 1);
+  }
+
+  void LinkBlock(Block *block) noexcept {
+    block->prev = last_;
+    if (last_ == nullptr) {
+      first_ = block;
+    } else {
+      last_->next = block;
+    }
+    last_ = block;
+  }
+
+  void UnlinkBlock(Block *block) noexcept {
+    (block->prev == nullptr ? first_ : block->prev->next) = block->next;
+    (block->next == nullptr ? last_ : block->next->prev) = block->prev;
+  }
+
+  void LinkFreeBlock(Block *block) noexcept {
+    block->prev_free = nullptr;
+    block->next_free = free_blocks_;
+    if (free_blocks_ != nullptr) {
+      free_blocks_->prev_free = block;
+    }
+    free_blocks_ = block;
+  }
+
+  void UnlinkFreeBlock(Block *block) noexcept {
+    (block->prev_free == nullptr ? free_blocks_
+                                 : block->prev_free->next_free) =
+        block->next_free;
+    if (block->next_free != nullptr) {
+      block->next_free->prev_free = block->prev_free;
+    }
+  }
+
+  // Adds the run starting at start to the free runs of block.
+  void PushRun(Block *block, size_type start) noexcept {
+    if (block->free_head == hive_internal::kNoRun) {
+      LinkFreeBlock(block);
+    } else {
+      block->runs[block->free_head].prev = static_cast<std::uint16_t>(start);
+    }
+    block->runs[start] = FreeRun{hive_internal::kNoRun, block->free_head};
+    block->free_head = static_cast<std::uint16_t>(start);
+  }
+
+  void RemoveRun(Block *block, size_type start) noexcept {
+    FreeRun run = block->runs[start];
+    if (run.prev == hive_internal::kNoRun) {
+      block->free_head = run.next;
+    } else {
+      block->runs[run.prev].next = run.next;
+    }
+    if (run.next != hive_internal::kNoRun) {
+      block->runs[run.next].prev = run.prev;
+    }
+    if (block->free_head == hive_internal::kNoRun) {
+      UnlinkFreeBlock(block);
+    }
+  }
+
+  // The run starting at from now starts at to.
+  void MoveRun(Block *block, size_type from, size_type to) noexcept {
+    FreeRun run = block->runs[from];
+    block->runs[to] = run;
+    if (run.prev == hive_internal::kNoRun) {
+      block->free_head = static_cast<std::uint16_t>(to);
+    } else {
+      block->runs[run.prev].next = static_cast<std::uint16_t>(to);
+    }
+    if (run.next != hive_internal::kNoRun) {
+      block->runs[run.next].prev = static_cast<std::uint16_t>(to);
+    }
+  }
+
+  // Marks the slot erased, merging it with the neighbouring runs.
+  void EraseSlot(Block *block, size_type index) noexcept {
+    std::uint16_t *skip = block->skip;
+    size_type before = index == 0 ? 0 : skip[index - 1];
+    size_type after = skip[index + 1];
+    size_type length = before + after + 1;
+    auto count = static_cast<std::uint16_t>(length);
+    if (before == 0 && after == 0) {
+      skip[index] = 1;
+      PushRun(block, index);
+    } else if (after == 0) {
+      skip[index - before] = count;
+      skip[index] = count;
+    } else if (before == 0) {
+      MoveRun(block, index + 1, index);
+      skip[index] = count;
+      skip[index + after] = count;
+    } else {
+      RemoveRun(block, index + 1);
+      skip[index - before] = count;
+      skip[index + after] = count;
+      skip[index] = 1;
+    }
+  }
+
+  // Marks the first slot of the first free run of block live.
+  void ReuseRunStart(Block *block) noexcept {
+    std::uint16_t *skip = block->skip;
+    size_type start = block->free_head;
+    size_type length = skip[start];
+    skip[start] = 0;
+    if (length == 1) {
+      RemoveRun(block, start);
+    } else {
+      auto count = static_cast<std::uint16_t>(length - 1);
+      skip[start + 1] = count;
+      skip[start + length - 1] = count;
+      MoveRun(block, start, start + 1);
+    }
+  }
+
+  void TakeStorage(hive &other) noexcept {
+    first_ = std::exchange(other.first_, nullptr);
+    last_ = std::exchange(other.last_, nullptr);
+    free_blocks_ = std::exchange(other.free_blocks_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+  }
+
+  // Expects an empty hive without blocks.
+  void MoveElementsFrom(hive &other) {
+    if (alloc_ == other.alloc_) {
+      TakeStorage(other);
+      return;
+    }
+    for (reference value : other) {
+      emplace(std::move(value));
+    }
+    other.clear();
+  }
+};
+
+template <typename T, typename Allocator>
+void swap(hive<T, Allocator> &lhs, hive<T, Allocator> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_HIVE_H
@@ -0,0 +1,187 @@
+#if !defined(CONTAINERS_LIB_INSTRUMENTATION_H)
+#define CONTAINERS_LIB_INSTRUMENTATION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace dizing {
+
+// Counts of allocations and element lifetime events.
+struct operation_counts {
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t allocated_bytes = 0;
+  std::size_t live_bytes = 0;
+  std::size_t peak_bytes = 0;
+  // Element constructions other than copies and moves
+  std::size_t constructions = 0;
+  // Copy and move constructions and assignments
+  std::size_t copies = 0;
+  std::size_t moves = 0;
+  std::size_t destructions = 0;
+
+  void reset() noexcept { *this = operation_counts(); }
+};
+
+namespace instrumentation_internal {
+
+// Counts of innermost counting_scope of the thread
+inline thread_local operation_counts *current_counts = nullptr;
+
+}  // namespace instrumentation_internal
+
+// Directs events of instrumented elements to counts while alive.
+// Scopes nest, the previous one is restored on destruction.
+class counting_scope {
+ public:
+  explicit counting_scope(operation_counts &counts) noexcept
+      : previous_(instrumentation_internal::current_counts) {
+    instrumentation_internal::current_counts = &counts;
+  }
+  counting_scope(const counting_scope &) = delete;
+  counting_scope &operator=(const counting_scope &) = delete;
+  ~counting_scope() { instrumentation_internal::current_counts = previous_; }
+
+ private:
+  operation_counts *previous_;
+};
+
+// Resets counts and records events of fn into them: element events through
+// counting_scope, allocations if counts belong to a counting_allocator.
+template <typename Function>
+operation_counts &count_operations(operation_counts &counts, Function fn) {
+  counts.reset();
+  counting_scope scope(counts);
+  fn();
+  return counts;
+}
+
+// Element wrapping T which counts its constructions, copies, moves and
+// destructions into the current counting_scope.
+template <typename T>
+struct instrumented {
+  T value;
+
+  instrumented() : value() { Record(&operation_counts::constructions); }
+  template <typename... Args,
+            typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
+  instrumented(Args &&...args) : value(std::forward<Args>(args)...) {
+    Record(&operation_counts::constructions);
+  }
+  instrumented(const instrumented &other) : value(other.value) {
+    Record(&operation_counts::copies);
+  }
+  instrumented(instrumented &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+      : value(std::move(other.value)) {
+    Record(&operation_counts::moves);
+  }
+  ~instrumented() { Record(&operation_counts::destructions); }
+
+  instrumented &operator=(const instrumented &other) {
+    value = other.value;
+    Record(&operation_counts::copies);
+    return *this;
+  }
+  instrumented &operator=(instrumented &&other) noexcept(
+      std::is_nothrow_move_assignable_v<T>) {
+    value = std::move(other.value);
+    Record(&operation_counts::moves);
+    return *this;
+  }
+
+  bool operator==(const instrumented &other) const {
+    return value == other.value;
+  }
+  bool operator!=(const instrumented &other) const {
+    return !(*this == other);
+  }
+  bool operator<(const instrumented &other) const {
+    return value < other.value;
+  }
+
+ private:
+  static void Record(std::size_t operation_counts::*counter) noexcept {
+    if (instrumentation_internal::current_counts != nullptr) {
+      ++(instrumentation_internal::current_counts->*counter);
+    }
+  }
+};
+
+// Allocator adapter recording allocations of Allocator into counts.
+// Copies and rebound copies share counts, so counts of a container cover its
+// nodes and buffers. Counts always propagate with the memory they describe.
+// Default constructed allocators count into a process wide unused_counts().
+template <typename T, typename Allocator = std::allocator<T>>
+class counting_allocator {
+  using base_traits = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = typename base_traits::is_always_equal;
+
+  template <typename U>
+  struct rebind {
+    using other =
+        counting_allocator<U, typename base_traits::template rebind_alloc<U>>;
+  };
+
+  counting_allocator() : counts_(&unused_counts()), base_() {}
+  explicit counting_allocator(operation_counts &counts,
+                              const Allocator &base = Allocator())
+      : counts_(&counts), base_(base) {}
+  counting_allocator(const counting_allocator &other) = default;
+  template <typename U, typename OtherAllocator>
+  counting_allocator(const counting_allocator<U, OtherAllocator> &other)
+      : counts_(other.counts_), base_(other.base_) {}
+
+  counting_allocator &operator=(const counting_allocator &other) = default;
+
+  T *allocate(std::size_t n) {
+    T *pointer = base_traits::allocate(base_, n);
+    ++counts_->allocations;
+    counts_->allocated_bytes += n * sizeof(T);
+    counts_->live_bytes += n * sizeof(T);
+    counts_->peak_bytes = std::max(counts_->peak_bytes, counts_->live_bytes);
+    return pointer;
+  }
+  void deallocate(T *pointer, std::size_t n) {
+    ++counts_->deallocations;
+    counts_->live_bytes -= n * sizeof(T);
+    base_traits::deallocate(base_, pointer, n);
+  }
+
+  operation_counts &counts() const noexcept { return *counts_; }
+
+  static operation_counts &unused_counts() noexcept {
+    static operation_counts counts;
+    return counts;
+  }
+
+  // Counts are statistics, they don't make allocators different
+  template <typename U, typename OtherAllocator>
+  bool operator==(const counting_allocator<U, OtherAllocator> &other) const {
+    return base_ == other.base_;
+  }
+  template <typename U, typename OtherAllocator>
+  bool operator!=(const counting_allocator<U, OtherAllocator> &other) const {
+    return !(*this == other);
+  }
+
+ private:
+  template <typename U, typename OtherAllocator>
+  friend class counting_allocator;
+
+  operation_counts *counts_;
+  Allocator base_;
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_INSTRUMENTATION_H
@@ -0,0 +1,201 @@
+#if !defined(CONTAINERS_LIB_INTRUSIVE_LIST_H)
+#define CONTAINERS_LIB_INTRUSIVE_LIST_H
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+#include "list.h"
+
+namespace dizing {
+
+// Member hook linking a user-owned object into an intrusive_list.
+// An unlinked hook points to itself. Copies of a hook are unlinked, and a
+// hook unlinks itself on destruction.
+class list_hook : public list_internal::BaseListNode {
+ public:
+  list_hook() noexcept : list_internal::BaseListNode{this, this} {}
+  list_hook(const list_hook &) noexcept : list_hook() {}
+  list_hook &operator=(const list_hook &) noexcept { return *this; }
+  ~list_hook() { Unhook(); }
+
+  bool is_linked() const noexcept { return next_ != this; }
+  // Removes the owner from its list in O(1).
+  void unlink() noexcept { Unhook(); }
+};
+
+namespace intrusive_list_internal {
+
+// Maps a hook to the object owning it as member Hook.
+template <typename T, list_hook T::*Hook>
+struct HookOwner {
+  static T &Get(list_internal::BaseListNode *node) noexcept {
+    auto hook = reinterpret_cast<unsigned char *>(
+        static_cast<list_hook *>(node));
+    return *reinterpret_cast<T *>(hook - Offset());
+  }
+  static const T &Get(const list_internal::BaseListNode *node) noexcept {
+    auto hook = reinterpret_cast<const unsigned char *>(
+        static_cast<const list_hook *>(node));
+    return *reinterpret_cast<const T *>(hook - Offset());
+  }
+
+  // Offset of the hook inside T. No object is needed: the Itanium C++ ABI
+  // followed by GCC and Clang represents a pointer to data member as the
+  // offset of the member, so this folds into a constant.
+  static std::ptrdiff_t Offset() noexcept {
+    static_assert(sizeof(Hook) == sizeof(std::ptrdiff_t),
+                  "pointer to data member must be a ptrdiff_t offset");
+    list_hook T::*hook = Hook;
+    std::ptrdiff_t offset = 0;
+    std::memcpy(&offset, &hook, sizeof(offset));
+    return offset;
+  }
+};
+
+}  // namespace intrusive_list_internal
+
+// Doubly linked list of objects owning a list_hook member: linking never
+// allocates or copies, the list only threads the hooks of its elements.
+// An element may be unlinked through its own hook, so size() is linear.
+// Elements must outlive their membership, the list doesn't own them.
+template <typename T, list_hook T::*Hook>
+class intrusive_list {
+ public:
+  using value_type = T;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = list_internal::ListIterator<
+      value_type, false, intrusive_list_internal::HookOwner<T, Hook>>;
+  using const_iterator = list_internal::ListIterator<
+      value_type, true, intrusive_list_internal::HookOwner<T, Hook>>;
+  using base_node = list_internal::BaseListNode;
+
+  // Constructors
+
+  intrusive_list() : head_() {}
+  intrusive_list(const intrusive_list &) = delete;
+  intrusive_list &operator=(const intrusive_list &) = delete;
+
+  // Elements of other are relinked, other becomes empty.
+  intrusive_list(intrusive_list &&other) noexcept : head_() {
+    splice(end(), other);
+  }
+  intrusive_list &operator=(intrusive_list &&other) noexcept {
+    if (this != &other) {
+      clear();
+      splice(end(), other);
+    }
+    return *this;
+  }
+
+  // Unlinks all elements.
+  ~intrusive_list() { clear(); }
+
+  // Element Access
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *(--end()); }
+  const_reference back() const { return *(--end()); }
+
+  // Iterators
+  iterator begin() noexcept { return head_.next_; }
+  iterator end() noexcept { return &head_; }
+  const_iterator begin() const noexcept { return head_.next_; }
+  const_iterator end() const noexcept { return &head_; }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  // Iterator to a linked element, O(1).
+  static iterator iterator_to(reference value) noexcept {
+    return &(value.*Hook);
+  }
+  static const_iterator iterator_to(const_reference value) noexcept {
+    return &(value.*Hook);
+  }
+
+  // Capacity
+  bool empty() const noexcept { return head_.next_ == &head_; }
+  // Linear: elements may unlink themselves without the list knowing.
+  size_type size() const noexcept {
+    size_type count = 0;
+    for (const base_node *node = head_.next_; node != &head_;
+         node = node->next_) {
+      ++count;
+    }
+    return count;
+  }
+
+  // Modifiers
+
+  // Links value before pos, value must not be linked.
+  iterator insert(const_iterator pos, reference value) noexcept {
+    (value.*Hook).HookBefore(NodeOf(pos));
+    return iterator_to(value);
+  }
+  void push_back(reference value) noexcept { insert(end(), value); }
+  void push_front(reference value) noexcept { insert(begin(), value); }
+
+  // Unlinks elements, they are not destroyed.
+  iterator erase(const_iterator pos) noexcept {
+    base_node *node = NodeOf(pos);
+    iterator next(node->next_);
+    node->Unhook();
+    return next;
+  }
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    while (first != last) {
+      first = erase(first);
+    }
+    return NodeOf(last);
+  }
+  void pop_back() noexcept { erase(--end()); }
+  void pop_front() noexcept { erase(begin()); }
+
+  void clear() noexcept {
+    while (!empty()) {
+      head_.next_->Unhook();
+    }
+  }
+
+  void swap(intrusive_list &other) noexcept {
+    base_node::swap(head_, other.head_);
+  }
+
+  // Splice functions relink elements in O(1).
+  void splice(const_iterator pos, intrusive_list &other) noexcept {
+    if (&other == this) {
+      return;
+    }
+    base_node::Transfer(NodeOf(pos), other.head_.next_, &other.head_);
+  }
+
+  // Moves element it of other before pos. other may be this list.
+  void splice(const_iterator pos, intrusive_list &,
+              const_iterator it) noexcept {
+    base_node *node = NodeOf(it);
+    if (NodeOf(pos) != node) {
+      base_node::Transfer(NodeOf(pos), node, node->next_);
+    }
+  }
+
+  // Moves elements [first, last) of other before pos. other may be this
+  // list, then pos must not be in [first, last).
+  void splice(const_iterator pos, intrusive_list &, const_iterator first,
+              const_iterator last) noexcept {
+    base_node::Transfer(NodeOf(pos), NodeOf(first), NodeOf(last));
+  }
+
+ private:
+  list_hook head_;
+
+  static base_node *NodeOf(const_iterator pos) noexcept {
+    return const_cast<base_node *>(pos.GetNode());
+  }
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_INTRUSIVE_LIST_H
@@ -2,7 +2,10 @@
 #define CONTAINERS_LIB_LIST_H
 
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace dizing {
 
@@ -27,6 +30,21 @@ struct BaseListNode {
     prev_ = this;
     next_ = this;
   }
+  // Unhooks nodes [first, last) and hooks them before pos.
+  // pos must not be in [first, last).
+  static void Transfer(BaseListNode *pos, BaseListNode *first,
+                       BaseListNode *last) noexcept {
+    if (first == last || pos == last) {
+      return;
+    }
+    BaseListNode *before_last = last->prev_;
+    first->prev_->next_ = last;
+    last->prev_ = first->prev_;
+    first->prev_ = pos->prev_;
+    pos->prev_->next_ = first;
+    before_last->next_ = pos;
+    pos->prev_ = before_last;
+  }
   static void swap(BaseListNode &lhs, BaseListNode &rhs) {
     BaseListNode *lhs_next = lhs.next_;
     BaseListNode *rhs_next = rhs.next_;
@@ -51,9 +69,23 @@ struct ListNode : public BaseListNode {
   // ListNode(Args &&...value) : value_(T(std::forward<Args>(value)...)) {}
 };
 
-template <typename T, bool isConst>
+// Element of a ListNode.
+template <typename T>
+struct NodeValue {
+  static T &Get(BaseListNode *node) noexcept {
+    return static_cast<ListNode<T> *>(node)->value_;
+  }
+  static const T &Get(const BaseListNode *node) noexcept {
+    return static_cast<const ListNode<T> *>(node)->value_;
+  }
+};
+
+// ValueOf maps a node to its element, see NodeValue.
+template <typename T, bool isConst, typename ValueOf = NodeValue<T>>
 class ListIterator {
  public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = std::ptrdiff_t;
   using value_type = T;
   using reference =
       typename std::conditional_t<isConst, const value_type &, value_type &>;
@@ -76,24 +108,24 @@ class ListIterator {
   template <
       bool otherIsConst,
       std::enable_if_t<isConst == true && otherIsConst == false, bool> = true>
-  ListIterator(const ListIterator<T, otherIsConst> &other)
+  ListIterator(const ListIterator<T, otherIsConst, ValueOf> &other)
       : node_(other.node_) {}
 
-  ListIterator<T, isConst> &operator++() {
+  ListIterator &operator++() {
     node_ = node_->next_;
     return *this;
   }
-  ListIterator<T, isConst> operator++(int) {
-    ListIterator<T, isConst> temp(*this);
+  ListIterator operator++(int) {
+    ListIterator temp(*this);
     ++(*this);
     return temp;
   }
-  ListIterator<T, isConst> &operator--() {
+  ListIterator &operator--() {
     node_ = node_->prev_;
     return *this;
   }
-  ListIterator<T, isConst> operator--(int) {
-    ListIterator<T, isConst> temp(*this);
+  ListIterator operator--(int) {
+    ListIterator temp(*this);
     --(*this);
     return temp;
   }
@@ -101,9 +133,8 @@ class ListIterator {
     node_ = other.node_;
     return *this;
   }
-  reference operator*() const {
-    return static_cast<node_pointer>(node_)->value_;
-  }
+  reference operator*() const { return ValueOf::Get(node_); }
+  pointer operator->() const { return &ValueOf::Get(node_); }
   base_node_pointer GetNode() const noexcept { return node_; }
   bool operator==(const ListIterator &other) const {
     return node_ == other.node_;
@@ -122,6 +153,7 @@ class list {
   using iterator = list_internal::ListIterator<value_type, false>;
   using const_iterator = list_internal::ListIterator<value_type, true>;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
   using base_node = list_internal::BaseListNode;
   using node = list_internal::ListNode<value_type>;
   using value_traits = std::allocator_traits<Allocator>;
@@ -130,14 +162,16 @@ class list {
 
   // Constructors
 
-  list()
-      : node_alloc_(node_alloc()),
-        val_alloc_(Allocator()),
+  list() : list(Allocator()) {}
+
+  explicit list(const Allocator &alloc)
+      : node_alloc_(alloc),
+        val_alloc_(alloc),
         size_(0),
         fakeNode_({&fakeNode_, &fakeNode_}) {}
 
   explicit list(size_type n, const Allocator &alloc = Allocator())
-      : node_alloc_(node_alloc()),
+      : node_alloc_(alloc),
         val_alloc_(alloc),
         size_(0),
         fakeNode_({&fakeNode_, &fakeNode_}) {
@@ -146,37 +180,29 @@ class list {
     }
   }
 
-  list(const std::initializer_list<value_type> &items)
-      : node_alloc_(node_alloc()),
-        val_alloc_(Allocator()),
-        size_(0),
-        fakeNode_({&fakeNode_, &fakeNode_}) {
-    try {
-      for (auto &element : items) {
-        push_back(element);
-      }
-    } catch (...) {
-      clear();
-      throw;
+  // Delegating constructors: once list(alloc) is done, the destructor frees
+  // already created nodes if the rest throws.
+  template <typename Iter,
+            typename = typename std::iterator_traits<Iter>::iterator_category>
+  list(Iter first, Iter last, const Allocator &alloc = Allocator())
+      : list(alloc) {
+    for (; first != last; ++first) {
+      emplace_back(*first);
     }
   }
 
+  list(const std::initializer_list<value_type> &items,
+       const Allocator &alloc = Allocator())
+      : list(items.begin(), items.end(), alloc) {}
+
   list(const list &other)
-      : node_alloc_(other.node_alloc_),
-        val_alloc_(other.val_alloc_),
-        size_(0),
-        fakeNode_({&fakeNode_, &fakeNode_}) {
-    try {
-      for (auto &element : other) {
-        push_back(element);
-      }
-    } catch (...) {
-      clear();
-      throw;
-    }
-  }
+      : list(other, value_traits::select_on_container_copy_construction(
+                        other.val_alloc_)) {}
 
-  list(list &&other)
+  list(const list &other, const Allocator &alloc)
+      : list(other.begin(), other.end(), alloc) {}
+
+  list(list &&other) noexcept
       : node_alloc_(std::move(other.node_alloc_)),
         val_alloc_(std::move(other.val_alloc_)),
         size_(other.size_),
@@ -188,21 +214,50 @@ class list {
     }
   }
 
+  // Nodes are stolen if allocators are equal, otherwise elements are moved
+  // into new nodes.
+  list(list &&other, const Allocator &alloc) : list(alloc) {
+    MoveElementsFrom(other);
+  }
+
   ~list() { clear(); }
 
-  list &operator=(const list &l) {
-    if (this != &l) {
-      list(l).swap(*this);
+  // Strong exception safety: elements are copied into a new list first.
+  // The allocator of other is taken if it propagates on copy assignment.
+  list &operator=(const list &other) {
+    if (this != &other) {
+      constexpr bool kPropagate =
+          value_traits::propagate_on_container_copy_assignment::value;
+      list copy(other, kPropagate ? other.val_alloc_ : val_alloc_);
+      clear();
+      if constexpr (kPropagate) {
+        node_alloc_ = other.node_alloc_;
+        val_alloc_ = other.val_alloc_;
+      }
+      splice(end(), copy);
     }
     return *this;
   }
 
-  list &operator=(list &&l) {
-    list temp(std::move(l));
-    swap(temp);
+  // O(1) if the allocator propagates or both allocators are equal, otherwise
+  // elements are moved one by one into nodes of our allocator.
+  list &operator=(list &&other) noexcept(
+      value_traits::propagate_on_container_move_assignment::value ||
+      value_traits::is_always_equal::value) {
+    if (this != &other) {
+      clear();
+      if constexpr (value_traits::propagate_on_container_move_assignment::
+                        value) {
+        node_alloc_ = other.node_alloc_;
+        val_alloc_ = other.val_alloc_;
+      }
+      MoveElementsFrom(other);
+    }
     return *this;
   }
 
+  Allocator get_allocator() const { return val_alloc_; }
+
   // Element Access
   const_reference front() const { return *begin(); }
   const_reference back() const { return *(--end()); }
@@ -258,12 +313,13 @@ class list {
 
   void pop_front() { EraseNode(begin()); }
 
+  // Allocators are exchanged only if they propagate on swap, otherwise they
+  // must be equal.
   void swap(list &other) {
-    // node_alloc node_alloc_tmp = node_alloc_;
-    // node_alloc_ = other.node_alloc_;
-    // other.node_alloc_ = node_alloc_tmp;
-    std::swap(node_alloc_, other.node_alloc_);
-    std::swap(val_alloc_, other.val_alloc_);
+    if constexpr (value_traits::propagate_on_container_swap::value) {
+      std::swap(node_alloc_, other.node_alloc_);
+      std::swap(val_alloc_, other.val_alloc_);
+    }
     std::swap(size_, other.size_);
     base_node::swap(fakeNode_, other.fakeNode_);
   }
@@ -281,47 +337,77 @@ class list {
   }
   // Merge two lists.
   // No elements are copied
-  // Basic exception safety(not all other list elements will be merged)
+  // Basic exception safety(all other list elements are moved to this list,
+  // but may stay unsorted)
   template <class Compare>
   void merge(list &&other, Compare comp) {
-    if (&other == this) {
+    if (&other == this || other.empty()) {
       return;
     }
-    iterator first = begin();
-    iterator second = other.begin();
-    while (first != end() && second != other.end()) {
-      if (comp(*second, *first)) {
-        TransferNodeBefore(first.GetNode(), second++);
-        ++size_;
-        --other.size_;
-      } else {
-        ++first;
-      }
-    }
-    while (second != other.end()) {
-      TransferNodeBefore(first.GetNode()->next_, second++);
-      ++size_;
-      --other.size_;
-    }
+    iterator middle = other.begin();
+    base_node::Transfer(&fakeNode_, other.fakeNode_.next_, &other.fakeNode_);
+    size_ += other.size_;
+    other.size_ = 0;
+    MergeRuns(begin(), middle, end(), comp);
   }
 
+  // Splice functions relink nodes without copies or allocations.
+  // Allocators of both lists must be equal.
   void splice(const_iterator pos, list &other) {
     splice(pos, std::move(other));
   }
 
   void splice(const_iterator pos, list &&other) {
-    base_node_pointer pos_node = (IteratorConstCast(pos).GetNode());
-    base_node_pointer other_first_node = other.begin().GetNode();
-    base_node_pointer other_last_node = (--other.end()).GetNode();
-    other_first_node->prev_ = pos_node->prev_;
-    pos_node->prev_->next_ = other_first_node;
-    other_last_node->next_ = pos_node;
-    pos_node->prev_ = other_last_node;
+    if (&other == this || other.empty()) {
+      return;
+    }
+    base_node::Transfer(IteratorConstCast(pos).GetNode(),
+                        other.fakeNode_.next_, &other.fakeNode_);
     size_ += other.size_;
-    other.fakeNode_ = {&other.fakeNode_, &other.fakeNode_};
     other.size_ = 0;
   }
 
+  // Moves element it of other before pos. other may be this list.
+  void splice(const_iterator pos, list &other, const_iterator it) {
+    splice(pos, std::move(other), it);
+  }
+
+  void splice(const_iterator pos, list &&other, const_iterator it) {
+    base_node_pointer node = IteratorConstCast(it).GetNode();
+    base_node_pointer pos_node = IteratorConstCast(pos).GetNode();
+    if (pos_node == node) {
+      return;
+    }
+    base_node::Transfer(pos_node, node, node->next_);
+    if (&other != this) {
+      ++size_;
+      --other.size_;
+    }
+  }
+
+  // Moves elements [first, last) of other before pos. other may be this list,
+  // then pos must not be in [first, last).
+  // O(1) within one list, counting moved elements is linear otherwise.
+  void splice(const_iterator pos, list &other, const_iterator first,
+              const_iterator last) {
+    splice(pos, std::move(other), first, last);
+  }
+
+  void splice(const_iterator pos, list &&other, const_iterator first,
+              const_iterator last) {
+    if (&other != this) {
+      size_type count = 0;
+      for (const_iterator it = first; it != last; ++it) {
+        ++count;
+      }
+      size_ += count;
+      other.size_ -= count;
+    }
+    base_node::Transfer(IteratorConstCast(pos).GetNode(),
+                        IteratorConstCast(first).GetNode(),
+                        IteratorConstCast(last).GetNode());
+  }
+
   void reverse() {
     iterator it = begin();
     while (it != end()) {
@@ -342,10 +428,51 @@ class list {
     sort<decltype(comparator)>(comparator);
   }
 
-  // Sorting by selection sort O(n^2)
+  // Stable bottom-up merge sort O(n log n).
+  // Only node links are changed: no allocations, no element copies.
+  // Nodes are taken one by one into a carry run, which is merged with bins
+  // of sorted runs of 1, 2, 4, ... nodes like a binary counter.
+  // Basic exception safety(elements stay in the list in unspecified order)
   template <typename Compare>
   void sort(Compare comp) {
-    SelectionSort<Compare>(comp);
+    if (size_ < 2) {
+      return;
+    }
+    // 2^64 nodes don't fit into memory
+    constexpr size_type kMaxBins = 64;
+    base_node carry;
+    base_node bins[kMaxBins];
+    InitEmptyRun(carry);
+    for (base_node &bin : bins) {
+      InitEmptyRun(bin);
+    }
+    size_type used_bins = 0;
+    try {
+      // size_ stays unchanged while nodes are in bins
+      while (fakeNode_.next_ != &fakeNode_) {
+        base_node::Transfer(&carry, fakeNode_.next_, fakeNode_.next_->next_);
+        size_type i = 0;
+        for (; i < used_bins && bins[i].next_ != &bins[i]; ++i) {
+          MergeRunInto(bins[i], carry, comp);
+          base_node::swap(carry, bins[i]);
+        }
+        base_node::swap(carry, bins[i]);
+        if (i == used_bins) {
+          ++used_bins;
+        }
+      }
+      for (size_type i = 1; i < used_bins; ++i) {
+        MergeRunInto(bins[i], bins[i - 1], comp);
+      }
+    } catch (...) {
+      base_node::Transfer(&fakeNode_, carry.next_, &carry);
+      for (size_type i = 0; i < used_bins; ++i) {
+        base_node::Transfer(&fakeNode_, bins[i].next_, &bins[i]);
+      }
+      throw;
+    }
+    base_node::Transfer(&fakeNode_, bins[used_bins - 1].next_,
+                        &bins[used_bins - 1]);
   }
 
   void unique() {
@@ -435,6 +562,19 @@ class list {
     tmp->HookBefore(pos.GetNode());
   }
 
+  // Appends elements of other, other becomes empty. Nodes are relinked if
+  // allocators are equal, otherwise elements are moved into new nodes.
+  void MoveElementsFrom(list &other) {
+    if (val_alloc_ == other.val_alloc_) {
+      splice(end(), other);
+    } else {
+      for (auto &element : other) {
+        emplace_back(std::move(element));
+      }
+      other.clear();
+    }
+  }
+
   // Const cast from const iterator to non-const iterator
   iterator IteratorConstCast(const_iterator pos) const {
     iterator temp(
@@ -442,19 +582,37 @@ class list {
     return temp;
   }
 
+  static void InitEmptyRun(base_node &head) noexcept {
+    head.prev_ = &head;
+    head.next_ = &head;
+  }
+
+  // Merges sorted adjacent runs [first, middle) and [middle, last) by
+  // relinking nodes. Stable: equal elements of the first run go first.
   template <class Compare>
-  void SelectionSort(Compare comp) {
-    list temp;
-    while (size_ > 0) {
-      iterator min_element(begin());
-      for (auto it = begin(); it != end(); ++it) {
-        min_element = (comp(*it, *min_element)) ? it : min_element;
+  void MergeRuns(iterator first, iterator middle, iterator last,
+                 Compare &comp) {
+    while (first != middle && middle != last) {
+      if (comp(*middle, *first)) {
+        TransferNodeBefore(first, middle++);
+      } else {
+        ++first;
       }
-      temp.TransferNodeBefore(temp.end(), min_element);
-      --size_;
-      ++temp.size_;
     }
-    swap(temp);
+  }
+
+  // Moves sorted run headed by source to the end of sorted run headed by
+  // destination and merges them.
+  template <class Compare>
+  void MergeRunInto(base_node &destination, base_node &source,
+                    Compare &comp) {
+    if (source.next_ == &source) {
+      return;
+    }
+    iterator middle(source.next_);
+    base_node::Transfer(&destination, source.next_, &source);
+    MergeRuns(iterator(destination.next_), middle, iterator(&destination),
+              comp);
   }
 };
 
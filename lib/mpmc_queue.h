@@ -0,0 +1,226 @@
+#if !defined(CONTAINERS_LIB_MPMC_QUEUE_H)
+#define CONTAINERS_LIB_MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "array.h"
+
+namespace dizing {
+
+namespace mpmc_queue_internal {
+
+// Assumed size of a cache line: separates positions written by producers
+// and consumers.
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// Ring slot. sequence tells whose turn it is: equal to the position of the
+// next push into the slot while empty, to that position + 1 once filled.
+template <typename T>
+struct Slot {
+  std::atomic<std::size_t> sequence;
+  alignas(T) unsigned char storage[sizeof(T)];
+
+  T *Value() noexcept { return reinterpret_cast<T *>(storage); }
+};
+
+}  // namespace mpmc_queue_internal
+
+// Bounded lock-free multi-producer multi-consumer queue of N elements
+// (D. Vyukov): a producer or consumer claims a position by one CAS on the
+// tail or head, then publishes the slot through its sequence number.
+// try_* never block and fail if the queue is full or empty. N must be a
+// power of two. Elements are constructed after a slot is claimed, so the
+// construction must not throw; throwing arguments are converted to T
+// before claiming.
+template <typename T, std::size_t N>
+class mpmc_queue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0,
+                "capacity must be a power of two");
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                    std::is_nothrow_destructible_v<T>,
+                "elements must be nothrow movable");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  mpmc_queue() noexcept : tail_(0), head_(0), slots_() {
+    for (size_type i = 0; i < N; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+  // Destroys remaining elements, no other thread may use the queue.
+  ~mpmc_queue() {
+    size_type head = head_.load(std::memory_order_relaxed);
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+      slots_[head & kMask].Value()->~T();
+    }
+  }
+
+  static constexpr size_type capacity() noexcept { return N; }
+
+  // Number of elements at some moment during the call.
+  size_type size_approx() const noexcept {
+    size_type head = head_.load(std::memory_order_relaxed);
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool try_push(const T &value) { return try_emplace(value); }
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+  template <typename... Args>
+  bool try_emplace(Args &&...args) {
+    if constexpr (std::is_nothrow_constructible_v<T, Args &&...>) {
+      size_type position = 0;
+      if (ClaimPush(1, position) == 0) {
+        return false;
+      }
+      Publish(position, std::forward<Args>(args)...);
+      return true;
+    } else {
+      return try_emplace(T(std::forward<Args>(args)...));
+    }
+  }
+
+  // Pops the oldest element into value.
+  bool try_pop(T &value) { return try_pop_batch(&value, 1) == 1; }
+
+  // Pushes a prefix of [first, last) which fits with one CAS, returns its
+  // length. Elements are constructed from *first, pass move iterators to
+  // move them.
+  template <typename Iter>
+  size_type try_push_batch(Iter first, Iter last) {
+    using reference = typename std::iterator_traits<Iter>::reference;
+    static_assert(std::is_nothrow_constructible_v<T, reference>,
+                  "batch elements must be nothrow constructible");
+    size_type wanted = static_cast<size_type>(std::distance(first, last));
+    size_type position = 0;
+    size_type count = ClaimPush(wanted, position);
+    for (size_type i = 0; i < count; ++i, ++first) {
+      Publish(position + i, *first);
+    }
+    return count;
+  }
+
+  // Pops up to max_count elements with one CAS and assigns them to out in
+  // order, returns their number. If assignment throws, the rest of the
+  // claimed elements is dropped.
+  template <typename OutIter>
+  size_type try_pop_batch(OutIter out, size_type max_count) {
+    size_type position = 0;
+    size_type count = ClaimPop(max_count, position);
+    size_type i = 0;
+    try {
+      for (; i < count; ++i, ++out) {
+        *out = std::move(*slots_[(position + i) & kMask].Value());
+        Release(position + i);
+      }
+    } catch (...) {
+      for (; i < count; ++i) {
+        Release(position + i);
+      }
+      throw;
+    }
+    return count;
+  }
+
+ private:
+  using slot = mpmc_queue_internal::Slot<T>;
+  static constexpr size_type kMask = N - 1;
+
+  alignas(mpmc_queue_internal::kCacheLineSize) std::atomic<size_type> tail_;
+  alignas(mpmc_queue_internal::kCacheLineSize) std::atomic<size_type> head_;
+  alignas(mpmc_queue_internal::kCacheLineSize) array<slot, N> slots_;
+
+  static std::intptr_t Lag(size_type sequence, size_type position) noexcept {
+    return static_cast<std::intptr_t>(sequence - position);
+  }
+
+  // Claims up to wanted consecutive empty slots, returns their number and
+  // stores the first position. A slot empty for position stays so until
+  // the tail moves past position, so one CAS validates all of them.
+  size_type ClaimPush(size_type wanted, size_type &position) {
+    if (wanted == 0) {
+      return 0;
+    }
+    position = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      size_type count = 0;
+      while (count < wanted &&
+             slots_[(position + count) & kMask].sequence.load(
+                 std::memory_order_acquire) == position + count) {
+        ++count;
+      }
+      if (count == 0) {
+        size_type sequence =
+            slots_[position & kMask].sequence.load(std::memory_order_acquire);
+        if (Lag(sequence, position) < 0) {
+          return 0;  // Full: the slot still holds an element of a lap ago.
+        }
+        position = tail_.load(std::memory_order_relaxed);
+      } else if (tail_.compare_exchange_weak(position, position + count,
+                                             std::memory_order_relaxed)) {
+        return count;
+      }
+    }
+  }
+
+  // Claims up to wanted consecutive filled slots, like ClaimPush.
+  size_type ClaimPop(size_type wanted, size_type &position) {
+    if (wanted == 0) {
+      return 0;
+    }
+    position = head_.load(std::memory_order_relaxed);
+    while (true) {
+      size_type count = 0;
+      while (count < wanted &&
+             slots_[(position + count) & kMask].sequence.load(
+                 std::memory_order_acquire) == position + count + 1) {
+        ++count;
+      }
+      if (count == 0) {
+        size_type sequence =
+            slots_[position & kMask].sequence.load(std::memory_order_acquire);
+        if (Lag(sequence, position + 1) < 0) {
+          return 0;  // Empty: the slot waits for a push.
+        }
+        position = head_.load(std::memory_order_relaxed);
+      } else if (head_.compare_exchange_weak(position, position + count,
+                                             std::memory_order_relaxed)) {
+        return count;
+      }
+    }
+  }
+
+  // Constructs the element of a claimed position and hands it to consumers.
+  template <typename... Args>
+  void Publish(size_type position, Args &&...args) noexcept {
+    slot &target = slots_[position & kMask];
+    ::new (static_cast<void *>(target.Value()))
+        T(std::forward<Args>(args)...);
+    target.sequence.store(position + 1, std::memory_order_release);
+  }
+
+  // Destroys the element of a claimed position and hands the slot to the
+  // producer of the next lap.
+  void Release(size_type position) noexcept {
+    slot &target = slots_[position & kMask];
+    target.Value()->~T();
+    target.sequence.store(position + N, std::memory_order_release);
+  }
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_MPMC_QUEUE_H
@@ -0,0 +1,482 @@
+#if !defined(CONTAINERS_LIB_PARALLEL_H)
+#define CONTAINERS_LIB_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "deque.h"
+#include "vector.h"
+
+namespace dizing {
+namespace parallel {
+
+class thread_pool;
+
+namespace parallel_internal {
+
+// Chunks are at least this large, half of a typical L1 data cache, so a
+// task amortizes scheduling and works on cache resident data.
+inline constexpr std::size_t kMinChunkBytes = 16 * 1024;
+inline constexpr std::size_t kCacheLineSize = 64;
+// Chunks per thread, more chunks balance uneven work.
+inline constexpr std::size_t kChunksPerThread = 4;
+
+// Pool and queue of the worker running on this thread, if any.
+struct WorkerSlot {
+  const thread_pool *pool;
+  std::size_t queue;
+};
+inline thread_local WorkerSlot current_worker = {nullptr, 0};
+
+// Elements per task for count elements of element_size bytes on threads
+// threads: whole cache lines so chunks written in parallel don't share
+// lines, and no smaller than kMinChunkBytes.
+inline std::size_t ChunkSize(std::size_t count, std::size_t element_size,
+                             std::size_t threads) {
+  std::size_t min_chunk =
+      std::max<std::size_t>(1, kMinChunkBytes / element_size);
+  std::size_t tasks = threads * kChunksPerThread;
+  std::size_t chunk = std::max(min_chunk, (count + tasks - 1) / tasks);
+  if (element_size < kCacheLineSize && kCacheLineSize % element_size == 0) {
+    std::size_t line = kCacheLineSize / element_size;
+    chunk = (chunk + line - 1) / line * line;
+  }
+  return chunk;
+}
+
+}  // namespace parallel_internal
+
+// Work stealing pool of size() - 1 worker threads; the thread waiting for
+// tasks runs them too. Every worker owns a deque of tasks: it takes its own
+// newest tasks and steals the oldest ones of the others. Tasks spawned
+// outside the workers go to a shared queue.
+class thread_pool {
+ public:
+  using size_type = std::size_t;
+
+  explicit thread_pool(
+      size_type threads = std::max(1u, std::thread::hardware_concurrency()))
+      : threads_(std::max<size_type>(1, threads)),
+        queues_(std::make_unique<WorkQueue[]>(threads_)),
+        workers_(),
+        queued_(0),
+        sleep_mutex_(),
+        wake_(),
+        stop_(false) {
+    workers_.reserve(threads_ - 1);
+    for (size_type queue = 1; queue < threads_; ++queue) {
+      workers_.emplace_back([this, queue] { WorkerLoop(queue); });
+    }
+  }
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+  // Tasks must be finished, see task_group.
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  // Threads running tasks, including the waiting one.
+  size_type size() const noexcept { return threads_; }
+
+ private:
+  friend class task_group;
+
+  struct WorkQueue {
+    std::mutex mutex = std::mutex();
+    deque<std::function<void()>> tasks = deque<std::function<void()>>();
+  };
+
+  size_type threads_;
+  std::unique_ptr<WorkQueue[]> queues_;
+  vector<std::thread> workers_;
+  std::atomic<size_type> queued_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_;
+
+  size_type OwnQueue() const noexcept {
+    const parallel_internal::WorkerSlot &worker =
+        parallel_internal::current_worker;
+    return worker.pool == this ? worker.queue : 0;
+  }
+
+  void Push(std::function<void()> task) {
+    WorkQueue &queue = queues_[OwnQueue()];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    wake_.notify_one();
+  }
+
+  // Runs the newest task of the own queue or the oldest of another one.
+  bool TryRunOne() {
+    size_type own = OwnQueue();
+    std::function<void()> task;
+    for (size_type i = 0; i < threads_ && !task; ++i) {
+      WorkQueue &queue = queues_[(own + i) % threads_];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        if (i == 0) {
+          task = std::move(queue.tasks.back());
+          queue.tasks.pop_back();
+        } else {
+          task = std::move(queue.tasks.front());
+          queue.tasks.pop_front();
+        }
+      }
+    }
+    if (!task) {
+      return false;
+    }
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+  }
+
+  void WorkerLoop(size_type queue) {
+    parallel_internal::current_worker = {this, queue};
+    while (true) {
+      if (TryRunOne()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      wake_.wait(lock, [this] {
+        return stop_ || queued_.load(std::memory_order_acquire) > 0;
+      });
+      if (stop_ && queued_.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+    }
+  }
+};
+
+// Tasks spawned on a pool and waited for together. wait() runs queued
+// tasks until all tasks of the group finished, so groups nest inside tasks
+// without blocking workers. The first exception thrown by a task is
+// rethrown by wait(). The destructor waits too, so tasks may refer to
+// locals of the spawning scope even if it is left by an exception.
+class task_group {
+ public:
+  explicit task_group(thread_pool &pool)
+      : pool_(pool), pending_(0), error_mutex_(), error_() {}
+  task_group(const task_group &) = delete;
+  task_group &operator=(const task_group &) = delete;
+  ~task_group() { Join(); }
+
+  template <typename F>
+  void run(F &&task) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    try {
+      pool_.Push([this, task = std::forward<F>(task)]() mutable {
+        try {
+          task();
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(error_mutex_);
+          if (!error_) {
+            error_ = std::current_exception();
+          }
+        }
+        pending_.fetch_sub(1, std::memory_order_release);
+      });
+    } catch (...) {
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      throw;
+    }
+  }
+
+  void wait() {
+    Join();
+    std::exception_ptr error;
+    {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      std::swap(error, error_);
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  thread_pool &pool_;
+  std::atomic<std::size_t> pending_;
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+
+  void Join() noexcept {
+    while (pending_.load(std::memory_order_acquire) > 0) {
+      if (!pool_.TryRunOne()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+
+// Pool of hardware_concurrency threads used when none is given.
+inline thread_pool &default_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+namespace parallel_internal {
+
+// Calls body(begin, end) on chunks of [0, count) in parallel, the last
+// chunk on the calling thread. Chunk c starts at c * ChunkSize().
+template <typename Body>
+void ForEachChunk(thread_pool &pool, std::size_t count,
+                  std::size_t element_size, Body &&body) {
+  std::size_t chunk = ChunkSize(count, element_size, pool.size());
+  task_group group(pool);
+  std::size_t begin = 0;
+  for (; count - begin > chunk; begin += chunk) {
+    group.run([&body, begin, chunk] { body(begin, begin + chunk); });
+  }
+  if (begin < count) {
+    body(begin, count);
+  }
+  group.wait();
+}
+
+// Stable merge of sorted runs [first1, last1) and [first2, last2) into
+// out, split recursively at the middle of the longer run.
+template <typename Iter, typename Out, typename Compare>
+void Merge(thread_pool &pool, Iter first1, Iter last1, Iter first2,
+           Iter last2, Out out, Compare &comp, std::size_t grain) {
+  auto size1 = static_cast<std::size_t>(last1 - first1);
+  auto size2 = static_cast<std::size_t>(last2 - first2);
+  if (size1 + size2 <= grain) {
+    std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1),
+               std::make_move_iterator(first2), std::make_move_iterator(last2),
+               out, comp);
+    return;
+  }
+  Iter mid1;
+  Iter mid2;
+  if (size1 >= size2) {
+    // Equal elements of the second run stay after mid1
+    mid1 = first1 + static_cast<std::ptrdiff_t>(size1 / 2);
+    mid2 = std::lower_bound(first2, last2, *mid1, comp);
+  } else {
+    // Equal elements of the first run stay before mid2
+    mid2 = first2 + static_cast<std::ptrdiff_t>(size2 / 2);
+    mid1 = std::upper_bound(first1, last1, *mid2, comp);
+  }
+  Out mid_out = out + (mid1 - first1) + (mid2 - first2);
+  task_group group(pool);
+  group.run([&] {
+    Merge(pool, first1, mid1, first2, mid2, out, comp, grain);
+  });
+  Merge(pool, mid1, last1, mid2, last2, mid_out, comp, grain);
+  group.wait();
+}
+
+// Sorts [first, last) stably, leaving the result there if in_place and in
+// [buffer, buffer + (last - first)) otherwise. Both ranges hold elements.
+template <typename Iter, typename Buffer, typename Compare>
+void MergeSort(thread_pool &pool, Iter first, Iter last, Buffer buffer,
+               bool in_place, Compare &comp, std::size_t grain) {
+  auto size = static_cast<std::size_t>(last - first);
+  if (size <= grain) {
+    std::stable_sort(first, last, comp);
+    if (!in_place) {
+      std::move(first, last, buffer);
+    }
+    return;
+  }
+  auto half = static_cast<std::ptrdiff_t>(size / 2);
+  Iter middle = first + half;
+  Buffer buffer_middle = buffer + half;
+  Buffer buffer_last = buffer + static_cast<std::ptrdiff_t>(size);
+  {
+    task_group group(pool);
+    group.run([&] {
+      MergeSort(pool, first, middle, buffer, !in_place, comp, grain);
+    });
+    MergeSort(pool, middle, last, buffer_middle, !in_place, comp, grain);
+    group.wait();
+  }
+  if (in_place) {
+    Merge(pool, buffer, buffer_middle, buffer_middle, buffer_last, first,
+          comp, grain);
+  } else {
+    Merge(pool, first, middle, middle, last, buffer, comp, grain);
+  }
+}
+
+}  // namespace parallel_internal
+
+// Algorithms over random access ranges, such as those of vector, array and
+// span. Each takes the pool to run on first, or runs on default_pool().
+// The range is split into chunks sized by ChunkSize; operations are called
+// concurrently and must not race with each other.
+
+// Calls f on every element.
+template <typename Iter, typename F>
+void for_each(thread_pool &pool, Iter first, Iter last, F f) {
+  using value_type = typename std::iterator_traits<Iter>::value_type;
+  parallel_internal::ForEachChunk(
+      pool, static_cast<std::size_t>(last - first), sizeof(value_type),
+      [first, &f](std::size_t begin, std::size_t end) {
+        std::for_each(first + static_cast<std::ptrdiff_t>(begin),
+                      first + static_cast<std::ptrdiff_t>(end), f);
+      });
+}
+
+template <typename Iter, typename F>
+void for_each(Iter first, Iter last, F f) {
+  for_each(default_pool(), first, last, std::move(f));
+}
+
+// Writes op(element) to the range starting at out, returns its end.
+template <typename Iter, typename Out, typename UnaryOp>
+Out transform(thread_pool &pool, Iter first, Iter last, Out out, UnaryOp op) {
+  using value_type = typename std::iterator_traits<Iter>::value_type;
+  auto count = static_cast<std::size_t>(last - first);
+  parallel_internal::ForEachChunk(
+      pool, count, sizeof(value_type),
+      [first, out, &op](std::size_t begin, std::size_t end) {
+        auto offset = static_cast<std::ptrdiff_t>(begin);
+        std::transform(first + offset,
+                       first + static_cast<std::ptrdiff_t>(end),
+                       out + offset, op);
+      });
+  return out + static_cast<std::ptrdiff_t>(count);
+}
+
+template <typename Iter, typename Out, typename UnaryOp>
+Out transform(Iter first, Iter last, Out out, UnaryOp op) {
+  return transform(default_pool(), first, last, out, std::move(op));
+}
+
+// Combines init and the elements by the associative op, in unspecified
+// grouping.
+template <typename Iter, typename T, typename BinaryOp = std::plus<>>
+T reduce(thread_pool &pool, Iter first, Iter last, T init,
+         BinaryOp op = BinaryOp()) {
+  using value_type = typename std::iterator_traits<Iter>::value_type;
+  auto count = static_cast<std::size_t>(last - first);
+  std::size_t chunk =
+      parallel_internal::ChunkSize(count, sizeof(value_type), pool.size());
+  vector<T> partials((count + chunk - 1) / chunk, init);
+  parallel_internal::ForEachChunk(
+      pool, count, sizeof(value_type),
+      [first, chunk, &op, &partials](std::size_t begin, std::size_t end) {
+        auto it = first + static_cast<std::ptrdiff_t>(begin);
+        T partial = *it;
+        for (++it; it != first + static_cast<std::ptrdiff_t>(end); ++it) {
+          partial = op(std::move(partial), *it);
+        }
+        partials[begin / chunk] = std::move(partial);
+      });
+  for (T &partial : partials) {
+    init = op(std::move(init), std::move(partial));
+  }
+  return init;
+}
+
+template <typename Iter, typename T, typename BinaryOp = std::plus<>>
+T reduce(Iter first, Iter last, T init, BinaryOp op = BinaryOp()) {
+  return reduce(default_pool(), first, last, std::move(init), std::move(op));
+}
+
+// Writes the running op-sums of the elements to out, returns its end. Each
+// chunk is reduced, the chunk sums are scanned, then each chunk is scanned
+// from the sum of the chunks before it. out may be first.
+template <typename Iter, typename Out, typename BinaryOp = std::plus<>>
+Out inclusive_scan(thread_pool &pool, Iter first, Iter last, Out out,
+                   BinaryOp op = BinaryOp()) {
+  using value_type = typename std::iterator_traits<Iter>::value_type;
+  auto count = static_cast<std::size_t>(last - first);
+  if (count == 0) {
+    return out;
+  }
+  std::size_t chunk =
+      parallel_internal::ChunkSize(count, sizeof(value_type), pool.size());
+  std::size_t chunks = (count + chunk - 1) / chunk;
+  vector<value_type> sums(chunks, *first);
+  parallel_internal::ForEachChunk(
+      pool, count, sizeof(value_type),
+      [first, chunk, &op, &sums](std::size_t begin, std::size_t end) {
+        // The sum of the last chunk isn't needed
+        if (begin / chunk + 1 == sums.size()) {
+          return;
+        }
+        auto it = first + static_cast<std::ptrdiff_t>(begin);
+        value_type sum = *it;
+        for (++it; it != first + static_cast<std::ptrdiff_t>(end); ++it) {
+          sum = op(std::move(sum), *it);
+        }
+        sums[begin / chunk] = std::move(sum);
+      });
+  for (std::size_t i = 1; i < chunks; ++i) {
+    sums[i] = op(sums[i - 1], sums[i]);
+  }
+  parallel_internal::ForEachChunk(
+      pool, count, sizeof(value_type),
+      [first, out, chunk, &op, &sums](std::size_t begin, std::size_t end) {
+        auto offset = static_cast<std::ptrdiff_t>(begin);
+        auto it = first + offset;
+        auto last_in_chunk = first + static_cast<std::ptrdiff_t>(end);
+        Out dest = out + offset;
+        value_type sum = begin == 0 ? *it : op(sums[begin / chunk - 1], *it);
+        *dest = sum;
+        for (++it, ++dest; it != last_in_chunk; ++it, ++dest) {
+          sum = op(std::move(sum), *it);
+          *dest = sum;
+        }
+      });
+  return out + static_cast<std::ptrdiff_t>(count);
+}
+
+template <typename Iter, typename Out, typename BinaryOp = std::plus<>>
+Out inclusive_scan(Iter first, Iter last, Out out, BinaryOp op = BinaryOp()) {
+  return inclusive_scan(default_pool(), first, last, out, std::move(op));
+}
+
+// Stable merge sort: chunks are sorted in parallel and merged pairwise,
+// each merge split in parallel too. Uses a buffer of last - first
+// elements.
+template <typename Iter, typename Compare = std::less<>>
+void sort(thread_pool &pool, Iter first, Iter last,
+          Compare comp = Compare()) {
+  using value_type = typename std::iterator_traits<Iter>::value_type;
+  auto count = static_cast<std::size_t>(last - first);
+  std::size_t grain =
+      parallel_internal::ChunkSize(count, sizeof(value_type), pool.size());
+  if (count <= grain) {
+    std::stable_sort(first, last, comp);
+    return;
+  }
+  vector<value_type> buffer(std::make_move_iterator(first),
+                            std::make_move_iterator(last));
+  parallel_internal::MergeSort(pool, buffer.begin(), buffer.end(), first,
+                               false, comp, grain);
+}
+
+template <typename Iter, typename Compare = std::less<>>
+void sort(Iter first, Iter last, Compare comp = Compare()) {
+  sort(default_pool(), first, last, std::move(comp));
+}
+
+}  // namespace parallel
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_PARALLEL_H
@@ -0,0 +1,157 @@
+#if !defined(CONTAINERS_LIB_PMR_H)
+#define CONTAINERS_LIB_PMR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+#include "deque.h"
+#include "hive.h"
+#include "list.h"
+#include "slot_map.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "unrolled_list.h"
+#include "vector.h"
+
+namespace dizing {
+namespace pmr {
+
+// Containers allocating from a std::pmr::memory_resource. Nested pmr
+// containers get the resource of the outer one by uses-allocator
+// construction.
+template <typename T>
+using vector = dizing::vector<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using deque = dizing::deque<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using hive = dizing::hive<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using list = dizing::list<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using slot_map = dizing::slot_map<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T, std::size_t N>
+using small_vector =
+    dizing::small_vector<T, N, std::pmr::polymorphic_allocator<T>>;
+
+template <typename... Fields>
+using soa_vector =
+    dizing::basic_soa_vector<std::pmr::polymorphic_allocator<char>, Fields...>;
+
+template <typename T,
+          std::size_t K = unrolled_list_internal::DefaultNodeCapacity<T>()>
+using unrolled_list =
+    dizing::unrolled_list<T, K, std::pmr::polymorphic_allocator<T>>;
+
+// Bump allocator over blocks of upstream memory for request-scoped object
+// graphs: deallocation is a no-op, memory is reclaimed all at once.
+// reset() makes memory reusable and replaces used blocks with one block of
+// their total size, so a resource reused per request stops touching
+// upstream once warmed up. Not thread safe.
+class arena_resource : public std::pmr::memory_resource {
+ public:
+  explicit arena_resource(
+      std::size_t initial_size = 4096,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+      : upstream_(upstream),
+        blocks_(nullptr),
+        current_(nullptr),
+        end_(nullptr),
+        next_size_(std::max(initial_size, kMinBlockSize)),
+        block_count_(0) {}
+  arena_resource(const arena_resource &) = delete;
+  arena_resource &operator=(const arena_resource &) = delete;
+  ~arena_resource() override { release(); }
+
+  // Invalidates all memory handed out, keeps capacity.
+  void reset() {
+    if (block_count_ > 1) {
+      std::size_t total = 0;
+      for (Block *block = blocks_; block != nullptr; block = block->next) {
+        total += block->size;
+      }
+      release();
+      AddBlock(total);
+    } else if (blocks_ != nullptr) {
+      current_ = blocks_->Data();
+    }
+  }
+
+  // Invalidates all memory handed out and returns it to upstream.
+  void release() noexcept {
+    while (blocks_ != nullptr) {
+      Block *next = blocks_->next;
+      upstream_->deallocate(blocks_, blocks_->size, alignof(Block));
+      blocks_ = next;
+    }
+    current_ = nullptr;
+    end_ = nullptr;
+    block_count_ = 0;
+  }
+
+  std::size_t block_count() const noexcept { return block_count_; }
+  std::pmr::memory_resource *upstream_resource() const noexcept {
+    return upstream_;
+  }
+
+ private:
+  // Header at the start of each upstream block
+  struct alignas(std::max_align_t) Block {
+    Block *next;
+    std::size_t size;
+    char *Data() { return reinterpret_cast<char *>(this + 1); }
+    char *End() { return reinterpret_cast<char *>(this) + size; }
+  };
+
+  static constexpr std::size_t kMinBlockSize = 2 * sizeof(Block);
+
+  std::pmr::memory_resource *upstream_;
+  Block *blocks_;
+  char *current_;
+  char *end_;
+  std::size_t next_size_;
+  std::size_t block_count_;
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void *pointer = current_;
+    std::size_t space = static_cast<std::size_t>(end_ - current_);
+    if (current_ == nullptr ||
+        std::align(alignment, bytes, pointer, space) == nullptr) {
+      AddBlock(std::max(next_size_, sizeof(Block) + bytes + alignment));
+      pointer = current_;
+      space = static_cast<std::size_t>(end_ - current_);
+      std::align(alignment, bytes, pointer, space);
+    }
+    current_ = static_cast<char *>(pointer) + bytes;
+    return pointer;
+  }
+
+  void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  // Blocks grow geometrically, the rest of the current block is abandoned.
+  void AddBlock(std::size_t size) {
+    void *memory = upstream_->allocate(size, alignof(Block));
+    blocks_ = new (memory) Block{blocks_, size};
+    current_ = blocks_->Data();
+    end_ = blocks_->End();
+    next_size_ = std::max(next_size_, size) * 2;
+    ++block_count_;
+  }
+};
+
+}  // namespace pmr
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_PMR_H
@@ -0,0 +1,189 @@
+#if !defined(CONTAINERS_LIB_POOL_ALLOCATOR_H)
+#define CONTAINERS_LIB_POOL_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace dizing {
+
+namespace pool_internal {
+
+// Free lists of fixed size blocks carved from slabs.
+// Blocks of one slab are handed out in address order, freed blocks are
+// reused first. Memory returns to the system only when resource dies.
+// Not thread safe.
+class PoolResource {
+ public:
+  explicit PoolResource(std::size_t blocks_per_slab)
+      : blocks_per_slab_(blocks_per_slab), pools_() {}
+  PoolResource(const PoolResource &) = delete;
+  PoolResource &operator=(const PoolResource &) = delete;
+
+  ~PoolResource() {
+    for (Pool &pool : pools_) {
+      for (void *slab : pool.slabs) {
+        ::operator delete(slab, std::align_val_t(pool.alignment));
+      }
+    }
+  }
+
+  void *Allocate(std::size_t size, std::size_t alignment) {
+    Pool &pool = FindPool(size, alignment);
+    if (pool.free == nullptr) {
+      AddSlab(pool);
+    }
+    FreeBlock *block = pool.free;
+    pool.free = block->next;
+    --pool.free_count;
+    return block;
+  }
+
+  void Deallocate(void *pointer, std::size_t size,
+                  std::size_t alignment) noexcept {
+    Pool &pool = FindPool(size, alignment);
+    pool.free = new (pointer) FreeBlock{pool.free};
+    ++pool.free_count;
+  }
+
+  std::size_t SlabCount() const noexcept {
+    std::size_t count = 0;
+    for (const Pool &pool : pools_) {
+      count += pool.slabs.size();
+    }
+    return count;
+  }
+
+  std::size_t FreeCount() const noexcept {
+    std::size_t count = 0;
+    for (const Pool &pool : pools_) {
+      count += pool.free_count;
+    }
+    return count;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  // Blocks of one size class
+  struct Pool {
+    std::size_t block_size;
+    std::size_t alignment;
+    FreeBlock *free = nullptr;
+    std::size_t free_count = 0;
+    std::vector<void *> slabs;
+  };
+
+  std::size_t blocks_per_slab_;
+  // Few size classes are used at once, linear search is fast enough
+  std::vector<Pool> pools_;
+
+  static std::size_t BlockSize(std::size_t size, std::size_t alignment) {
+    std::size_t block_size = std::max(size, sizeof(FreeBlock));
+    return (block_size + alignment - 1) / alignment * alignment;
+  }
+
+  Pool &FindPool(std::size_t size, std::size_t alignment) {
+    alignment = std::max(alignment, alignof(FreeBlock));
+    std::size_t block_size = BlockSize(size, alignment);
+    for (Pool &pool : pools_) {
+      if (pool.block_size == block_size && pool.alignment == alignment) {
+        return pool;
+      }
+    }
+    pools_.push_back(Pool{block_size, alignment, nullptr, 0, {}});
+    return pools_.back();
+  }
+
+  // Threads blocks of a new slab into the free list in address order.
+  void AddSlab(Pool &pool) {
+    pool.slabs.reserve(pool.slabs.size() + 1);
+    auto slab = static_cast<char *>(::operator new(
+        pool.block_size * blocks_per_slab_, std::align_val_t(pool.alignment)));
+    pool.slabs.push_back(slab);
+    for (std::size_t i = blocks_per_slab_; i > 0; --i) {
+      pool.free = new (slab + (i - 1) * pool.block_size) FreeBlock{pool.free};
+    }
+    pool.free_count += blocks_per_slab_;
+  }
+};
+
+}  // namespace pool_internal
+
+// Allocator of single objects from a slab pool, intended for node based
+// containers: list<T, pool_allocator<T>> gets nodes from the pool.
+// Copies and rebound copies share the pool, a default constructed allocator
+// creates a new one. Arrays of several objects go to operator new.
+// Not thread safe.
+template <typename T, std::size_t BlocksPerSlab = 64>
+class pool_allocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  template <typename U>
+  struct rebind {
+    using other = pool_allocator<U, BlocksPerSlab>;
+  };
+
+  pool_allocator()
+      : resource_(
+            std::make_shared<pool_internal::PoolResource>(BlocksPerSlab)) {}
+
+  // Moved from allocator keeps the pool, as containers may still use it
+  pool_allocator(const pool_allocator &other) = default;
+
+  template <typename U>
+  pool_allocator(const pool_allocator<U, BlocksPerSlab> &other) noexcept
+      : resource_(other.resource_) {}
+
+  pool_allocator &operator=(const pool_allocator &other) = default;
+
+  T *allocate(std::size_t n) {
+    if (n == 1) {
+      return static_cast<T *>(resource_->Allocate(sizeof(T), alignof(T)));
+    }
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+  }
+
+  void deallocate(T *pointer, std::size_t n) noexcept {
+    if (n == 1) {
+      resource_->Deallocate(pointer, sizeof(T), alignof(T));
+    } else {
+      ::operator delete(pointer, std::align_val_t(alignof(T)));
+    }
+  }
+
+  // Number of slabs allocated by the pool for all block sizes
+  std::size_t slab_count() const noexcept { return resource_->SlabCount(); }
+  // Number of blocks ready for reuse without allocating a slab
+  std::size_t free_nodes() const noexcept { return resource_->FreeCount(); }
+
+  template <typename U>
+  bool operator==(const pool_allocator<U, BlocksPerSlab> &other) const {
+    return resource_ == other.resource_;
+  }
+  template <typename U>
+  bool operator!=(const pool_allocator<U, BlocksPerSlab> &other) const {
+    return !(*this == other);
+  }
+
+ private:
+  template <typename U, std::size_t>
+  friend class pool_allocator;
+
+  std::shared_ptr<pool_internal::PoolResource> resource_;
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_POOL_ALLOCATOR_H
@@ -0,0 +1,682 @@
+#if !defined(CONTAINERS_LIB_SIMD_H)
+#define CONTAINERS_LIB_SIMD_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "array.h"
+#include "vector.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DIZING_SIMD_X86 1
+#endif
+
+namespace dizing {
+namespace simd {
+
+// Instruction sets of the kernels, from the slowest.
+enum class isa { scalar, sse2, avx2, avx512 };
+
+// Whether the CPU runs the kernels of level.
+inline bool supported(isa level) noexcept {
+#if defined(DIZING_SIMD_X86)
+  __builtin_cpu_init();
+  switch (level) {
+    case isa::scalar:
+    case isa::sse2:
+      return __builtin_cpu_supports("sse2");
+    case isa::avx2:
+      return __builtin_cpu_supports("avx2");
+    case isa::avx512:
+      return __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx512bw");
+  }
+  return false;
+#else
+  return level == isa::scalar;
+#endif
+}
+
+}  // namespace simd
+
+namespace simd_internal {
+
+inline simd::isa BestIsa() noexcept {
+  for (simd::isa level : {simd::isa::avx512, simd::isa::avx2,
+                          simd::isa::sse2}) {
+    if (simd::supported(level)) {
+      return level;
+    }
+  }
+  return simd::isa::scalar;
+}
+
+inline std::atomic<simd::isa> &ActiveIsa() noexcept {
+  static std::atomic<simd::isa> active(BestIsa());
+  return active;
+}
+
+// Element types with vector kernels.
+template <typename T>
+inline constexpr bool kVectorizable =
+    (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// Sums and products of integers wrap around like unsigned ones.
+template <typename T, bool = std::is_integral_v<T>>
+struct AccumulatorOf {
+  using type = T;
+};
+template <typename T>
+struct AccumulatorOf<T, true> {
+  using type = std::make_unsigned_t<T>;
+};
+template <typename T>
+using Accumulator = typename AccumulatorOf<T>::type;
+
+// Type of value arguments, not deduced: the element type comes from the
+// range alone and values convert to it, e.g. fill(doubles, 0).
+template <typename T>
+using NonDeduced = typename std::common_type<T>::type;
+
+// Element count known at compile time.
+template <std::size_t N>
+using FixedCount = std::integral_constant<std::size_t, N>;
+
+// Element by element loops, for any arithmetic T. Size is std::size_t or
+// a FixedCount.
+struct Scalar {
+  template <typename T, typename Size>
+  static void Fill(T *data, Size count, T value) {
+    for (std::size_t i = 0; i < count; ++i) {
+      data[i] = value;
+    }
+  }
+  template <typename T, typename Size>
+  static std::size_t Find(const T *data, Size count, T value) {
+    std::size_t i = 0;
+    while (i < count && !(data[i] == value)) {
+      ++i;
+    }
+    return i;
+  }
+  template <typename T, typename Size>
+  static std::size_t Count(const T *data, Size count, T value) {
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      found += data[i] == value;
+    }
+    return found;
+  }
+  template <typename T, typename Size>
+  static bool Equal(const T *lhs, const T *rhs, Size count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (!(lhs[i] == rhs[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  template <typename T, typename Size>
+  static T Min(const T *data, Size count) {
+    T result = data[0];
+    for (std::size_t i = 1; i < count; ++i) {
+      result = data[i] < result ? data[i] : result;
+    }
+    return result;
+  }
+  template <typename T, typename Size>
+  static T Max(const T *data, Size count) {
+    T result = data[0];
+    for (std::size_t i = 1; i < count; ++i) {
+      result = result < data[i] ? data[i] : result;
+    }
+    return result;
+  }
+  template <typename T, typename Size>
+  static T Sum(const T *data, Size count) {
+    using Acc = Accumulator<T>;
+    Acc sum = Acc();
+    for (std::size_t i = 0; i < count; ++i) {
+      sum = static_cast<Acc>(sum + static_cast<Acc>(data[i]));
+    }
+    return static_cast<T>(sum);
+  }
+  template <typename T, typename Size>
+  static T Dot(const T *lhs, const T *rhs, Size count) {
+    using Acc = Accumulator<T>;
+    Acc sum = Acc();
+    for (std::size_t i = 0; i < count; ++i) {
+      sum = static_cast<Acc>(
+          sum + static_cast<Acc>(static_cast<Acc>(lhs[i]) *
+                                 static_cast<Acc>(rhs[i])));
+    }
+    return static_cast<T>(sum);
+  }
+};
+
+#if defined(DIZING_SIMD_X86)
+
+#define DIZING_SIMD_INLINE __attribute__((always_inline)) inline
+
+// Kernels over Width byte vectors, written with GCC vector extensions and
+// inlined into functions compiled for an instruction set, which picks the
+// instructions. Vectors are loaded and stored with memcpy, so data needs
+// no alignment. Tails shorter than a vector are handled element by element.
+template <std::size_t Width, typename T>
+struct Kernels {
+  using Acc = Accumulator<T>;
+  typedef T Vector __attribute__((vector_size(Width)));
+  typedef Acc AccVector __attribute__((vector_size(Width)));
+  // Made dependent, GCC ignores vector_size on non-dependent types here
+  using Word = std::conditional_t<Width != 0, std::uint64_t, T>;
+  typedef Word Words __attribute__((vector_size(Width)));
+  // Lanes of comparison results are 0 or -1.
+  using MaskLane = std::conditional_t<
+      sizeof(T) == 1, std::int8_t,
+      std::conditional_t<
+          sizeof(T) == 2, std::int16_t,
+          std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>>>;
+  typedef MaskLane Mask __attribute__((vector_size(Width)));
+
+  static constexpr std::size_t kLanes = Width / sizeof(T);
+  static constexpr std::size_t kWords = Width / sizeof(std::uint64_t);
+
+  template <typename Size>
+  static DIZING_SIMD_INLINE void Fill(T *data, Size count, T value) {
+    const std::size_t size = count;
+    const std::size_t vector_end = size / kLanes * kLanes;
+    Vector splat = Vector() + value;
+    for (std::size_t i = 0; i < vector_end; i += kLanes) {
+      std::memcpy(data + i, &splat, Width);
+    }
+    for (std::size_t i = vector_end; i < size; ++i) {
+      data[i] = value;
+    }
+  }
+
+  template <typename Size>
+  static DIZING_SIMD_INLINE std::size_t Find(const T *data, Size count,
+                                             T value) {
+    const std::size_t size = count;
+    Vector splat = Vector() + value;
+    std::size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes) {
+      Vector block;
+      std::memcpy(&block, data + i, Width);
+      Mask equal = block == splat;
+      Words words;
+      std::memcpy(&words, &equal, Width);
+      std::uint64_t any = 0;
+      for (std::size_t w = 0; w < kWords; ++w) {
+        any |= words[w];
+      }
+      if (any != 0) {
+        break;
+      }
+    }
+    while (i < size && !(data[i] == value)) {
+      ++i;
+    }
+    return i;
+  }
+
+  template <typename Size>
+  static DIZING_SIMD_INLINE std::size_t Count(const T *data, Size count,
+                                              T value) {
+    const std::size_t size = count;
+    // Lanes count down by one per match, flushed before they overflow
+    constexpr std::size_t kFlush = std::min<std::size_t>(
+        std::numeric_limits<MaskLane>::max(), std::size_t{1} << 20);
+    const std::size_t vector_end = size / kLanes * kLanes;
+    Vector splat = Vector() + value;
+    std::size_t found = 0;
+    std::size_t i = 0;
+    while (i < vector_end) {
+      Mask matches = Mask();
+      for (std::size_t block = 0; block < kFlush && i < vector_end;
+           ++block, i += kLanes) {
+        Vector values;
+        std::memcpy(&values, data + i, Width);
+        matches += values == splat;
+      }
+      for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        found += static_cast<std::size_t>(-matches[lane]);
+      }
+    }
+    for (i = vector_end; i < size; ++i) {
+      found += data[i] == value;
+    }
+    return found;
+  }
+
+  template <typename Size>
+  static DIZING_SIMD_INLINE bool Equal(const T *lhs, const T *rhs,
+                                       Size count) {
+    const std::size_t size = count;
+    const std::size_t vector_end = size / kLanes * kLanes;
+    for (std::size_t i = 0; i < vector_end; i += kLanes) {
+      Vector left;
+      Vector right;
+      std::memcpy(&left, lhs + i, Width);
+      std::memcpy(&right, rhs + i, Width);
+      Mask differ = left != right;
+      Words words;
+      std::memcpy(&words, &differ, Width);
+      std::uint64_t any = 0;
+      for (std::size_t w = 0; w < kWords; ++w) {
+        any |= words[w];
+      }
+      if (any != 0) {
+        return false;
+      }
+    }
+    for (std::size_t i = vector_end; i < size; ++i) {
+      if (!(lhs[i] == rhs[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // A partial last vector is loaded overlapping the one before, which
+  // doesn't change the minimum or maximum.
+  template <bool isMin, typename Size>
+  static DIZING_SIMD_INLINE T MinMax(const T *data, Size count) {
+    const std::size_t size = count;
+    if (size < kLanes) {
+      return isMin ? Scalar::Min(data, size) : Scalar::Max(data, size);
+    }
+    Vector result;
+    std::memcpy(&result, data, Width);
+    std::size_t i = kLanes;
+    for (; i + kLanes <= size; i += kLanes) {
+      Vector values;
+      std::memcpy(&values, data + i, Width);
+      if constexpr (isMin) {
+        result = values < result ? values : result;
+      } else {
+        result = result < values ? values : result;
+      }
+    }
+    if (i < size) {
+      Vector values;
+      std::memcpy(&values, data + size - kLanes, Width);
+      if constexpr (isMin) {
+        result = values < result ? values : result;
+      } else {
+        result = result < values ? values : result;
+      }
+    }
+    T lanes[kLanes];
+    std::memcpy(lanes, &result, Width);
+    return isMin ? Scalar::Min(lanes, kLanes) : Scalar::Max(lanes, kLanes);
+  }
+
+  // Four independent accumulators hide the latency of the additions.
+  template <typename Size>
+  static DIZING_SIMD_INLINE T Sum(const T *data, Size count) {
+    const std::size_t size = count;
+    AccVector sums[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 * kLanes <= size; i += 4 * kLanes) {
+      for (std::size_t k = 0; k < 4; ++k) {
+        AccVector values;
+        std::memcpy(&values, data + i + k * kLanes, Width);
+        sums[k] += values;
+      }
+    }
+    for (; i + kLanes <= size; i += kLanes) {
+      AccVector values;
+      std::memcpy(&values, data + i, Width);
+      sums[0] += values;
+    }
+    return Finish(sums, data + i, size - i);
+  }
+
+  template <typename Size>
+  static DIZING_SIMD_INLINE T Dot(const T *lhs, const T *rhs, Size count) {
+    const std::size_t size = count;
+    AccVector sums[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 * kLanes <= size; i += 4 * kLanes) {
+      for (std::size_t k = 0; k < 4; ++k) {
+        AccVector left;
+        AccVector right;
+        std::memcpy(&left, lhs + i + k * kLanes, Width);
+        std::memcpy(&right, rhs + i + k * kLanes, Width);
+        sums[k] += left * right;
+      }
+    }
+    for (; i + kLanes <= size; i += kLanes) {
+      AccVector left;
+      AccVector right;
+      std::memcpy(&left, lhs + i, Width);
+      std::memcpy(&right, rhs + i, Width);
+      sums[0] += left * right;
+    }
+    T tail = Scalar::Dot(lhs + i, rhs + i, size - i);
+    return Finish(sums, &tail, 1);
+  }
+
+ private:
+  // Adds the lanes of the accumulators and count elements of rest.
+  static DIZING_SIMD_INLINE T Finish(AccVector (&sums)[4], const T *rest,
+                                     std::size_t count) {
+    AccVector total = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    Acc lanes[kLanes];
+    std::memcpy(lanes, &total, Width);
+    Acc sum = static_cast<Acc>(Scalar::Sum(rest, count));
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      sum = static_cast<Acc>(sum + lanes[lane]);
+    }
+    return static_cast<T>(sum);
+  }
+};
+
+// Kernels compiled for one instruction set, with the interface of Scalar.
+#define DIZING_SIMD_TARGET(Name, target_name, width)                 \
+  struct Name {                                                      \
+    template <typename T, typename Size>                             \
+    __attribute__((target(target_name))) static void Fill(           \
+        T *data, Size count, T value) {                              \
+      Kernels<width, T>::Fill(data, count, value);                   \
+    }                                                                \
+    template <typename T, typename Size>                             \
+    __attribute__((target(target_name))) static std::size_t Find(    \
+        const T *data, Size count, T value) {                        \
+      return Kernels<width, T>::Find(data, count, value);            \
+    }                                                                \
+    template <typename T, typename Size>                             \
+    __attribute__((target(target_name))) static std::size_t Count(   \
+        const T *data, Size count, T value) {                        \
+      return Kernels<width, T>::Count(data, count, value);           \
+    }                                                                \
+    template <typename T, typename Size>                             \
+    __attribute__((target(target_name))) static bool Equal(          \
+        const T *lhs, const T *rhs, Size count) {                    \
+      return Kernels<width, T>::Equal(lhs, rhs, count);              \
+    }                                                                \
+    template <typename T, typename Size>                             \
+    __attribute__((target(target_name))) static T Min(const T *data, \
+                                                      Size count) {  \
+      return Kernels<width, T>::template MinMax<true>(data, count);  \
+    }                                                                \
+    template <typename T, typename Size>                             \
+    __attribute__((target(target_name))) static T Max(const T *data, \
+                                                      Size count) {  \
+      return Kernels<width, T>::template MinMax<false>(data, count); \
+    }                                                                \
+    template <typename T, typename Size>                             \
+    __attribute__((target(target_name))) static T Sum(const T *data, \
+                                                      Size count) {  \
+      return Kernels<width, T>::Sum(data, count);                    \
+    }                                                                \
+    template <typename T, typename Size>                             \
+    __attribute__((target(target_name))) static T Dot(               \
+        const T *lhs, const T *rhs, Size count) {                    \
+      return Kernels<width, T>::Dot(lhs, rhs, count);                \
+    }                                                                \
+  }
+
+DIZING_SIMD_TARGET(Sse2, "sse2", 16);
+DIZING_SIMD_TARGET(Avx2, "avx2", 32);
+DIZING_SIMD_TARGET(Avx512, "avx512f,avx512bw", 64);
+
+#undef DIZING_SIMD_TARGET
+#undef DIZING_SIMD_INLINE
+
+#endif  // DIZING_SIMD_X86
+
+// Calls kernel with the kernels of the active instruction set.
+template <typename T, typename Kernel>
+auto Dispatch(Kernel &&kernel) {
+#if defined(DIZING_SIMD_X86)
+  if constexpr (kVectorizable<T>) {
+    switch (ActiveIsa().load(std::memory_order_relaxed)) {
+      case simd::isa::avx512:
+        return kernel(Avx512());
+      case simd::isa::avx2:
+        return kernel(Avx2());
+      case simd::isa::sse2:
+        return kernel(Sse2());
+      case simd::isa::scalar:
+        break;
+    }
+  }
+#endif
+  return kernel(Scalar());
+}
+
+// Arrays shorter than a vector of the narrowest instruction set are
+// handled element by element, inlined without dispatch.
+inline constexpr std::size_t kMinVectorBytes = 16;
+
+template <typename T, std::size_t N, typename Kernel>
+auto DispatchFixed(Kernel &&kernel) {
+  if constexpr (N * sizeof(T) < kMinVectorBytes) {
+    return kernel(Scalar());
+  } else {
+    return Dispatch<T>(kernel);
+  }
+}
+
+inline void CheckSizes(std::size_t lhs, std::size_t rhs) {
+  if (lhs != rhs) {
+    throw std::length_error("simd operands differ in size");
+  }
+}
+
+}  // namespace simd_internal
+
+// Bulk operations over contiguous arithmetic elements, run by kernels for
+// the best instruction set of the CPU, detected with CPUID on first use.
+// Types other than integers, float and double use the scalar kernels.
+// Arrays pass their size to the kernels at compile time. Sums and dot
+// products of integers wrap around; those of floating point numbers are
+// added in an unspecified order. min and max of ranges with NaNs are
+// unspecified.
+namespace simd {
+
+// Instruction set used by the operations.
+inline isa active_isa() noexcept {
+  return simd_internal::ActiveIsa().load(std::memory_order_relaxed);
+}
+
+// Uses the kernels of level from now on if the CPU supports them, e.g. to
+// compare instruction sets.
+inline bool set_active_isa(isa level) noexcept {
+  if (!supported(level)) {
+    return false;
+  }
+  simd_internal::ActiveIsa().store(level, std::memory_order_relaxed);
+  return true;
+}
+
+template <typename T>
+void fill(T *first, T *last, simd_internal::NonDeduced<T> value) {
+  auto count = static_cast<std::size_t>(last - first);
+  simd_internal::Dispatch<T>(
+      [&](auto kernels) { kernels.Fill(first, count, value); });
+}
+
+// Pointer to the first element equal to value, or last.
+template <typename T>
+const T *find(const T *first, const T *last,
+              simd_internal::NonDeduced<T> value) {
+  auto count = static_cast<std::size_t>(last - first);
+  return first + simd_internal::Dispatch<T>([&](auto kernels) {
+           return kernels.Find(first, count, value);
+         });
+}
+
+template <typename T>
+std::size_t count(const T *first, const T *last,
+                  simd_internal::NonDeduced<T> value) {
+  auto count = static_cast<std::size_t>(last - first);
+  return simd_internal::Dispatch<T>(
+      [&](auto kernels) { return kernels.Count(first, count, value); });
+}
+
+// Whether [first1, last1) and the range at first2 are equal element-wise.
+template <typename T>
+bool equal(const T *first1, const T *last1, const T *first2) {
+  auto count = static_cast<std::size_t>(last1 - first1);
+  return simd_internal::Dispatch<T>(
+      [&](auto kernels) { return kernels.Equal(first1, first2, count); });
+}
+
+// The range must not be empty.
+template <typename T>
+T min(const T *first, const T *last) {
+  auto count = static_cast<std::size_t>(last - first);
+  return simd_internal::Dispatch<T>(
+      [&](auto kernels) { return kernels.Min(first, count); });
+}
+
+// The range must not be empty.
+template <typename T>
+T max(const T *first, const T *last) {
+  auto count = static_cast<std::size_t>(last - first);
+  return simd_internal::Dispatch<T>(
+      [&](auto kernels) { return kernels.Max(first, count); });
+}
+
+template <typename T>
+T sum(const T *first, const T *last) {
+  auto count = static_cast<std::size_t>(last - first);
+  return simd_internal::Dispatch<T>(
+      [&](auto kernels) { return kernels.Sum(first, count); });
+}
+
+// Sum of the products of [first1, last1) and the range at first2.
+template <typename T>
+T dot(const T *first1, const T *last1, const T *first2) {
+  auto count = static_cast<std::size_t>(last1 - first1);
+  return simd_internal::Dispatch<T>(
+      [&](auto kernels) { return kernels.Dot(first1, first2, count); });
+}
+
+// array
+
+template <typename T, std::size_t N>
+void fill(array<T, N> &values, simd_internal::NonDeduced<T> value) {
+  simd_internal::DispatchFixed<T, N>([&](auto kernels) {
+    kernels.Fill(values.begin(), simd_internal::FixedCount<N>(), value);
+  });
+}
+
+template <typename T, std::size_t N>
+const T *find(const array<T, N> &values, simd_internal::NonDeduced<T> value) {
+  return values.begin() +
+         simd_internal::DispatchFixed<T, N>([&](auto kernels) {
+           return kernels.Find(values.begin(),
+                               simd_internal::FixedCount<N>(), value);
+         });
+}
+
+template <typename T, std::size_t N>
+std::size_t count(const array<T, N> &values,
+                  simd_internal::NonDeduced<T> value) {
+  return simd_internal::DispatchFixed<T, N>([&](auto kernels) {
+    return kernels.Count(values.begin(), simd_internal::FixedCount<N>(),
+                         value);
+  });
+}
+
+template <typename T, std::size_t N>
+bool equal(const array<T, N> &lhs, const array<T, N> &rhs) {
+  return simd_internal::DispatchFixed<T, N>([&](auto kernels) {
+    return kernels.Equal(lhs.begin(), rhs.begin(),
+                         simd_internal::FixedCount<N>());
+  });
+}
+
+template <typename T, std::size_t N>
+T min(const array<T, N> &values) {
+  static_assert(N > 0, "min of an empty array");
+  return simd_internal::DispatchFixed<T, N>([&](auto kernels) {
+    return kernels.Min(values.begin(), simd_internal::FixedCount<N>());
+  });
+}
+
+template <typename T, std::size_t N>
+T max(const array<T, N> &values) {
+  static_assert(N > 0, "max of an empty array");
+  return simd_internal::DispatchFixed<T, N>([&](auto kernels) {
+    return kernels.Max(values.begin(), simd_internal::FixedCount<N>());
+  });
+}
+
+template <typename T, std::size_t N>
+T sum(const array<T, N> &values) {
+  return simd_internal::DispatchFixed<T, N>([&](auto kernels) {
+    return kernels.Sum(values.begin(), simd_internal::FixedCount<N>());
+  });
+}
+
+template <typename T, std::size_t N>
+T dot(const array<T, N> &lhs, const array<T, N> &rhs) {
+  return simd_internal::DispatchFixed<T, N>([&](auto kernels) {
+    return kernels.Dot(lhs.begin(), rhs.begin(),
+                       simd_internal::FixedCount<N>());
+  });
+}
+
+// vector, small_vector
+
+template <typename T, typename A, typename G, std::size_t I>
+void fill(vector<T, A, G, I> &values, simd_internal::NonDeduced<T> value) {
+  fill(values.begin(), values.end(), value);
+}
+
+template <typename T, typename A, typename G, std::size_t I>
+const T *find(const vector<T, A, G, I> &values,
+              simd_internal::NonDeduced<T> value) {
+  return find(values.begin(), values.end(), value);
+}
+
+template <typename T, typename A, typename G, std::size_t I>
+std::size_t count(const vector<T, A, G, I> &values,
+                  simd_internal::NonDeduced<T> value) {
+  return count(values.begin(), values.end(), value);
+}
+
+// False if the sizes differ.
+template <typename T, typename A, typename G, std::size_t I>
+bool equal(const vector<T, A, G, I> &lhs, const vector<T, A, G, I> &rhs) {
+  return lhs.size() == rhs.size() &&
+         equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename A, typename G, std::size_t I>
+T min(const vector<T, A, G, I> &values) {
+  return min(values.begin(), values.end());
+}
+
+template <typename T, typename A, typename G, std::size_t I>
+T max(const vector<T, A, G, I> &values) {
+  return max(values.begin(), values.end());
+}
+
+template <typename T, typename A, typename G, std::size_t I>
+T sum(const vector<T, A, G, I> &values) {
+  return sum(values.begin(), values.end());
+}
+
+// Throws std::length_error if the sizes differ.
+template <typename T, typename A, typename G, std::size_t I>
+T dot(const vector<T, A, G, I> &lhs, const vector<T, A, G, I> &rhs) {
+  simd_internal::CheckSizes(lhs.size(), rhs.size());
+  return dot(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+}  // namespace simd
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_SIMD_H
@@ -0,0 +1,210 @@
+#if !defined(CONTAINERS_LIB_SLOT_MAP_H)
+#define CONTAINERS_LIB_SLOT_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+
+namespace dizing {
+
+// Handle of a slot_map value: the slot and its generation when the value
+// was inserted. Keys of erased values never find a later value in the
+// same slot until the 32 bit generation wraps around.
+struct slot_map_key {
+  std::uint32_t index;
+  std::uint32_t generation;
+
+  friend bool operator==(const slot_map_key &lhs, const slot_map_key &rhs) {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+  }
+  friend bool operator!=(const slot_map_key &lhs, const slot_map_key &rhs) {
+    return !(lhs == rhs);
+  }
+};
+
+// Values addressed by stable keys and stored densely in a vector, so
+// iteration is as fast as over a vector. A slot table maps keys to dense
+// positions; erase moves the last value into the hole, so it's O(1) but
+// changes the order of values and invalidates pointers to the moved one.
+// Free slots are reused in LIFO order.
+template <typename T, typename Allocator = std::allocator<T>>
+class slot_map {
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  struct Slot {
+    // Dense position of the value, or the next free slot.
+    std::uint32_t index;
+    std::uint32_t generation;
+  };
+
+  template <typename U>
+  using rebound = vector<U, typename alloc_traits::template rebind_alloc<U>>;
+
+ public:
+  using key_type = slot_map_key;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  slot_map() : slot_map(Allocator()) {}
+  explicit slot_map(const Allocator &alloc)
+      : values_(alloc), dense_slots_(alloc), slots_(alloc), free_(kNone) {}
+
+  allocator_type get_allocator() const { return values_.get_allocator(); }
+
+  // Lookup
+
+  // Value of key, nullptr if it was erased.
+  T *find(key_type key) noexcept {
+    return contains(key) ? values_.begin() + slots_[key.index].index
+                         : nullptr;
+  }
+  const T *find(key_type key) const noexcept {
+    return contains(key) ? values_.begin() + slots_[key.index].index
+                         : nullptr;
+  }
+  bool contains(key_type key) const noexcept {
+    return key.index < slots_.size() &&
+           slots_[key.index].generation == key.generation;
+  }
+  // key must be valid.
+  reference operator[](key_type key) noexcept {
+    return values_[slots_[key.index].index];
+  }
+  const_reference operator[](key_type key) const noexcept {
+    return values_[slots_[key.index].index];
+  }
+  reference at(key_type key) {
+    T *value = find(key);
+    if (value == nullptr) {
+      throw std::out_of_range("slot_map key was erased");
+    }
+    return *value;
+  }
+  const_reference at(key_type key) const {
+    const T *value = find(key);
+    if (value == nullptr) {
+      throw std::out_of_range("slot_map key was erased");
+    }
+    return *value;
+  }
+  // Key of the value at dense position pos, e.g. while iterating.
+  key_type key_at(size_type pos) const noexcept {
+    std::uint32_t slot = dense_slots_[pos];
+    return {slot, slots_[slot].generation};
+  }
+
+  // Iterators over the dense values.
+  iterator begin() noexcept { return values_.begin(); }
+  const_iterator begin() const noexcept { return values_.begin(); }
+  iterator end() noexcept { return values_.end(); }
+  const_iterator end() const noexcept { return values_.end(); }
+  T *data() noexcept { return values_.begin(); }
+  const T *data() const noexcept { return values_.begin(); }
+
+  // Capacity
+  size_type size() const noexcept { return values_.size(); }
+  bool empty() const noexcept { return size() == 0; }
+  void reserve(size_type new_capacity) {
+    values_.reserve(new_capacity);
+    dense_slots_.reserve(new_capacity);
+    slots_.reserve(new_capacity);
+  }
+
+  // Modifiers
+  key_type insert(const T &value) { return emplace(value); }
+  key_type insert(T &&value) { return emplace(std::move(value)); }
+
+  // Index vectors grow like vector; if appending to one throws, the new
+  // value is removed again.
+  template <typename... Args>
+  key_type emplace(Args &&...args) {
+    if (values_.size() == kNone) {
+      throw std::length_error("slot_map is full");
+    }
+    bool reuse = free_ != kNone;
+    std::uint32_t slot =
+        reuse ? free_ : static_cast<std::uint32_t>(slots_.size());
+    values_.emplace_back(std::forward<Args>(args)...);
+    try {
+      dense_slots_.push_back(slot);
+      if (!reuse) {
+        slots_.push_back(Slot{kNone, 0});
+      }
+    } catch (...) {
+      if (dense_slots_.size() == values_.size()) {
+        dense_slots_.pop_back();
+      }
+      values_.pop_back();
+      throw;
+    }
+    if (reuse) {
+      free_ = slots_[slot].index;
+    }
+    slots_[slot].index = static_cast<std::uint32_t>(values_.size() - 1);
+    return {slot, slots_[slot].generation};
+  }
+
+  // False if key was already erased.
+  bool erase(key_type key) {
+    if (!contains(key)) {
+      return false;
+    }
+    Slot &slot = slots_[key.index];
+    std::uint32_t pos = slot.index;
+    std::uint32_t last_slot = dense_slots_[values_.size() - 1];
+    if (pos + 1 != values_.size()) {
+      values_[pos] = std::move(values_[values_.size() - 1]);
+      dense_slots_[pos] = last_slot;
+      slots_[last_slot].index = pos;
+    }
+    values_.pop_back();
+    dense_slots_.pop_back();
+    ++slot.generation;
+    slot.index = free_;
+    free_ = key.index;
+    return true;
+  }
+
+  // Keys of all values become invalid.
+  void clear() {
+    for (std::uint32_t slot : dense_slots_) {
+      ++slots_[slot].generation;
+      slots_[slot].index = free_;
+      free_ = slot;
+    }
+    values_.clear();
+    dense_slots_.clear();
+  }
+
+  void swap(slot_map &other) {
+    values_.swap(other.values_);
+    dense_slots_.swap(other.dense_slots_);
+    slots_.swap(other.slots_);
+    std::swap(free_, other.free_);
+  }
+
+ private:
+  static constexpr std::uint32_t kNone =
+      std::numeric_limits<std::uint32_t>::max();
+
+  vector<T, Allocator> values_;
+  // Slot of each dense value
+  rebound<std::uint32_t> dense_slots_;
+  rebound<Slot> slots_;
+  // Head of the free slot list
+  std::uint32_t free_;
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_SLOT_MAP_H
@@ -0,0 +1,20 @@
+#if !defined(CONTAINERS_LIB_SMALL_VECTOR_H)
+#define CONTAINERS_LIB_SMALL_VECTOR_H
+
+#include "vector.h"
+
+namespace dizing {
+
+// vector that keeps up to N elements inside the object and allocates heap
+// memory only when it outgrows them. Growth continues from capacity N.
+// It is dizing::vector itself, so the API and insert/erase/growth machinery
+// are the same. Differences: moving or swapping a vector whose elements are
+// inline moves the elements one by one, and iterators to inline elements
+// are invalidated by such moves.
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = doubling_growth<>>
+using small_vector = vector<T, Allocator, GrowthPolicy, N>;
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_SMALL_VECTOR_H
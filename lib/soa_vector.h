@@ -0,0 +1,303 @@
+#if !defined(CONTAINERS_LIB_SOA_VECTOR_H)
+#define CONTAINERS_LIB_SOA_VECTOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "span.h"
+#include "vector.h"
+
+namespace dizing {
+
+namespace soa_vector_internal {
+
+// Row iterator over column pointers. Dereferencing yields a tuple of
+// references to the fields of the row, a proxy like the references of
+// std::vector<bool>.
+template <bool isConst, typename... Fields>
+class SoaIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::tuple<Fields...>;
+  using reference =
+      std::conditional_t<isConst, std::tuple<const Fields &...>,
+                         std::tuple<Fields &...>>;
+  using pointer = void;
+  using columns_type =
+      std::conditional_t<isConst, std::tuple<const Fields *...>,
+                         std::tuple<Fields *...>>;
+
+  SoaIterator() noexcept : columns_(), index_(0) {}
+  SoaIterator(columns_type columns, difference_type index) noexcept
+      : columns_(columns), index_(index) {}
+
+  // Non const to const
+  template <
+      bool otherIsConst,
+      std::enable_if_t<isConst == true && otherIsConst == false, bool> = true>
+  SoaIterator(const SoaIterator<otherIsConst, Fields...> &other) noexcept
+      : columns_(other.GetColumns()), index_(other.GetIndex()) {}
+
+  reference operator*() const {
+    return Row(std::index_sequence_for<Fields...>());
+  }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  SoaIterator &operator++() {
+    ++index_;
+    return *this;
+  }
+  SoaIterator operator++(int) {
+    SoaIterator temp(*this);
+    ++index_;
+    return temp;
+  }
+  SoaIterator &operator--() {
+    --index_;
+    return *this;
+  }
+  SoaIterator operator--(int) {
+    SoaIterator temp(*this);
+    --index_;
+    return temp;
+  }
+  SoaIterator &operator+=(difference_type n) {
+    index_ += n;
+    return *this;
+  }
+  SoaIterator &operator-=(difference_type n) {
+    index_ -= n;
+    return *this;
+  }
+  SoaIterator operator+(difference_type n) const {
+    SoaIterator temp(*this);
+    return temp += n;
+  }
+  friend SoaIterator operator+(difference_type n, const SoaIterator &it) {
+    return it + n;
+  }
+  SoaIterator operator-(difference_type n) const {
+    SoaIterator temp(*this);
+    return temp -= n;
+  }
+  difference_type operator-(const SoaIterator &other) const {
+    return index_ - other.index_;
+  }
+
+  bool operator==(const SoaIterator &other) const {
+    return index_ == other.index_;
+  }
+  bool operator!=(const SoaIterator &other) const {
+    return !(*this == other);
+  }
+  bool operator<(const SoaIterator &other) const {
+    return index_ < other.index_;
+  }
+  bool operator>(const SoaIterator &other) const { return other < *this; }
+  bool operator<=(const SoaIterator &other) const {
+    return !(other < *this);
+  }
+  bool operator>=(const SoaIterator &other) const {
+    return !(*this < other);
+  }
+
+  const columns_type &GetColumns() const noexcept { return columns_; }
+  difference_type GetIndex() const noexcept { return index_; }
+
+ private:
+  columns_type columns_;
+  difference_type index_;
+
+  template <std::size_t... I>
+  reference Row(std::index_sequence<I...>) const {
+    return reference(std::get<I>(columns_)[index_]...);
+  }
+};
+
+}  // namespace soa_vector_internal
+
+// Sequence of rows of Fields stored as one vector per field, so a scan of
+// some fields reads only their columns. Columns share the rebound
+// Allocator and grow together by the growth of vector. Rows are read and
+// written through tuples of references to their fields; columns are
+// contiguous spans, usable with the kernels of simd.h.
+template <typename Allocator, typename... Fields>
+class basic_soa_vector {
+  static_assert(sizeof...(Fields) > 0, "soa_vector needs a field");
+
+ public:
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields &...>;
+  using const_reference = std::tuple<const Fields &...>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using iterator = soa_vector_internal::SoaIterator<false, Fields...>;
+  using const_iterator = soa_vector_internal::SoaIterator<true, Fields...>;
+  template <std::size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+  template <typename T>
+  using column_type = vector<
+      T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+  basic_soa_vector() : basic_soa_vector(Allocator()) {}
+  explicit basic_soa_vector(const Allocator &alloc)
+      : columns_(column_type<Fields>(alloc)...) {}
+  basic_soa_vector(const basic_soa_vector &other) = default;
+  basic_soa_vector(basic_soa_vector &&other) = default;
+  basic_soa_vector &operator=(const basic_soa_vector &other) = default;
+  basic_soa_vector &operator=(basic_soa_vector &&other) = default;
+
+  allocator_type get_allocator() const {
+    return allocator_type(std::get<0>(columns_).get_allocator());
+  }
+
+  // Element access
+  reference operator[](size_type pos) { return begin()[Offset(pos)]; }
+  const_reference operator[](size_type pos) const {
+    return begin()[Offset(pos)];
+  }
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference back() { return (*this)[size() - 1]; }
+  const_reference back() const { return (*this)[size() - 1]; }
+
+  // Column I, invalidated by reallocation like vector::data().
+  template <std::size_t I>
+  span<field_type<I>> column() noexcept {
+    auto &values = std::get<I>(columns_);
+    return {values.begin(), values.size()};
+  }
+  template <std::size_t I>
+  span<const field_type<I>> column() const noexcept {
+    const auto &values = std::get<I>(columns_);
+    return {values.begin(), values.size()};
+  }
+
+  // Iterators
+  iterator begin() noexcept {
+    return iterator(Columns(std::index_sequence_for<Fields...>()), 0);
+  }
+  const_iterator begin() const noexcept {
+    return const_iterator(Columns(std::index_sequence_for<Fields...>()), 0);
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+  iterator end() noexcept { return begin() + Offset(size()); }
+  const_iterator end() const noexcept { return begin() + Offset(size()); }
+  const_iterator cend() const noexcept { return end(); }
+
+  // Capacity
+  size_type size() const noexcept { return std::get<0>(columns_).size(); }
+  bool empty() const noexcept { return size() == 0; }
+  size_type capacity() const noexcept {
+    return std::get<0>(columns_).capacity();
+  }
+  void reserve(size_type new_capacity) {
+    std::apply([&](auto &...values) { (values.reserve(new_capacity), ...); },
+               columns_);
+  }
+  void shrink_to_fit() {
+    std::apply([](auto &...values) { (values.shrink_to_fit(), ...); },
+               columns_);
+  }
+
+  // Modifiers
+
+  // Appends a row constructed from one argument per field. If constructing
+  // a field throws, the fields already appended are removed.
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    static_assert(sizeof...(Args) == sizeof...(Fields),
+                  "one argument per field");
+    EmplaceFields(std::index_sequence_for<Fields...>(),
+                  std::forward<Args>(args)...);
+    return back();
+  }
+  void push_back(const value_type &row) {
+    std::apply(
+        [this](const auto &...fields) { emplace_back(fields...); }, row);
+  }
+  void push_back(value_type &&row) {
+    std::apply(
+        [this](auto &...fields) { emplace_back(std::move(fields)...); },
+        row);
+  }
+  void pop_back() {
+    std::apply([](auto &...values) { (values.pop_back(), ...); }, columns_);
+  }
+  void clear() {
+    std::apply([](auto &...values) { (values.clear(), ...); }, columns_);
+  }
+  // New rows are value-initialized. If a field throws, all columns are
+  // shrunk back to the old size.
+  void resize(size_type count) {
+    ResizeColumns(std::index_sequence_for<Fields...>(), count);
+  }
+  void swap(basic_soa_vector &other) {
+    std::apply(
+        [&](auto &...values) {
+          std::apply(
+              [&](auto &...other_values) {
+                (values.swap(other_values), ...);
+              },
+              other.columns_);
+        },
+        columns_);
+  }
+
+ private:
+  std::tuple<column_type<Fields>...> columns_;
+
+  static difference_type Offset(size_type pos) noexcept {
+    return static_cast<difference_type>(pos);
+  }
+
+  template <std::size_t... I>
+  std::tuple<Fields *...> Columns(std::index_sequence<I...>) noexcept {
+    return std::tuple<Fields *...>(std::get<I>(columns_).begin()...);
+  }
+  template <std::size_t... I>
+  std::tuple<const Fields *...> Columns(
+      std::index_sequence<I...>) const noexcept {
+    return std::tuple<const Fields *...>(std::get<I>(columns_).begin()...);
+  }
+
+  template <std::size_t... I>
+  void ResizeColumns(std::index_sequence<I...>, size_type count) {
+    size_type old_size = size();
+    try {
+      (std::get<I>(columns_).resize(count), ...);
+    } catch (...) {
+      ((std::get<I>(columns_).size() > old_size
+            ? std::get<I>(columns_).resize(old_size)
+            : void()),
+       ...);
+      throw;
+    }
+  }
+
+  template <std::size_t... I, typename... Args>
+  void EmplaceFields(std::index_sequence<I...>, Args &&...args) {
+    std::size_t appended = 0;
+    try {
+      ((std::get<I>(columns_).emplace_back(std::forward<Args>(args)),
+        ++appended),
+       ...);
+    } catch (...) {
+      ((I < appended ? std::get<I>(columns_).pop_back() : void()), ...);
+      throw;
+    }
+  }
+};
+
+template <typename... Fields>
+using soa_vector = basic_soa_vector<std::allocator<char>, Fields...>;
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_SOA_VECTOR_H
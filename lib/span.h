@@ -0,0 +1,60 @@
+#if !defined(CONTAINERS_LIB_SPAN_H)
+#define CONTAINERS_LIB_SPAN_H
+
+#include <cstddef>
+#include <type_traits>
+
+namespace dizing {
+
+// Non-owning view of count contiguous elements, a C++17 subset of
+// std::span with dynamic extent.
+template <typename T>
+class span {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using reference = T &;
+  using pointer = T *;
+  using iterator = T *;
+
+  constexpr span() noexcept : data_(nullptr), size_(0) {}
+  constexpr span(pointer data, size_type size) noexcept
+      : data_(data), size_(size) {}
+  template <std::size_t N>
+  constexpr span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+  // Non const to const
+  template <typename U,
+            std::enable_if_t<std::is_same_v<const U, T> &&
+                                 !std::is_same_v<U, T>,
+                             bool> = true>
+  constexpr span(const span<U> &other) noexcept
+      : data_(other.data()), size_(other.size()) {}
+
+  constexpr iterator begin() const noexcept { return data_; }
+  constexpr iterator end() const noexcept { return data_ + size_; }
+  constexpr reference operator[](size_type pos) const { return data_[pos]; }
+  constexpr reference front() const { return data_[0]; }
+  constexpr reference back() const { return data_[size_ - 1]; }
+  constexpr pointer data() const noexcept { return data_; }
+  constexpr size_type size() const noexcept { return size_; }
+  constexpr size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr span first(size_type count) const { return {data_, count}; }
+  constexpr span last(size_type count) const {
+    return {data_ + size_ - count, count};
+  }
+  constexpr span subspan(size_type offset, size_type count) const {
+    return {data_ + offset, count};
+  }
+
+ private:
+  pointer data_;
+  size_type size_;
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_SPAN_H
@@ -0,0 +1,205 @@
+#if !defined(CONTAINERS_LIB_SPSC_RING_H)
+#define CONTAINERS_LIB_SPSC_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "array.h"
+#include "span.h"
+
+namespace dizing {
+
+namespace spsc_ring_internal {
+
+// Assumed size of a cache line: separates the producer and consumer state.
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// N elements inside the ring.
+template <typename T, std::size_t N, typename Allocator>
+class RingStorage {
+ public:
+  RingStorage(std::size_t capacity, const Allocator &) : buffer_() {
+    if (capacity != N) {
+      throw std::length_error("spsc_ring capacity is fixed");
+    }
+  }
+
+  T *Data() noexcept { return buffer_.data(); }
+  static constexpr std::size_t Capacity() noexcept { return N; }
+
+ private:
+  array<T, N> buffer_;
+};
+
+// Capacity chosen at runtime, elements allocated by Allocator.
+template <typename T, typename Allocator>
+class RingStorage<T, 0, Allocator> {
+ public:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  RingStorage(std::size_t capacity, const Allocator &alloc)
+      : alloc_(alloc),
+        capacity_(CheckCapacity(capacity)),
+        data_(alloc_traits::allocate(alloc_, capacity)) {
+    std::size_t constructed = 0;
+    try {
+      for (; constructed < capacity_; ++constructed) {
+        alloc_traits::construct(alloc_, data_ + constructed);
+      }
+    } catch (...) {
+      Destroy(constructed);
+      throw;
+    }
+  }
+  RingStorage(const RingStorage &) = delete;
+  RingStorage &operator=(const RingStorage &) = delete;
+  ~RingStorage() { Destroy(capacity_); }
+
+  T *Data() noexcept { return data_; }
+  std::size_t Capacity() const noexcept { return capacity_; }
+
+ private:
+  Allocator alloc_;
+  std::size_t capacity_;
+  T *data_;
+
+  static std::size_t CheckCapacity(std::size_t capacity) {
+    if (capacity == 0) {
+      throw std::length_error("spsc_ring capacity must be positive");
+    }
+    return capacity;
+  }
+
+  void Destroy(std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+      alloc_traits::destroy(alloc_, data_ + i);
+    }
+    alloc_traits::deallocate(alloc_, data_, capacity_);
+  }
+};
+
+}  // namespace spsc_ring_internal
+
+// Single-producer single-consumer ring over N elements, or over a buffer
+// of runtime capacity from Allocator if N is 0. Data is written and read in
+// place: the producer fills the span returned by reserve() and publishes it
+// by commit(), the consumer reads the span returned by peek() and frees it
+// by release(). Spans are contiguous, so they end at the end of the buffer.
+// Slots hold live default constructed elements which are overwritten.
+// Synchronization is one acquire load and one release store per side; the
+// position of the other side is cached and reloaded only when the cached
+// one doesn't suffice.
+template <typename T, std::size_t N = 0,
+          typename Allocator = std::allocator<T>>
+class spsc_ring {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  spsc_ring() : spsc_ring(N, Allocator()) {
+    static_assert(N > 0, "runtime sized ring needs a capacity");
+  }
+  // capacity must be N if N isn't 0.
+  explicit spsc_ring(size_type capacity, const Allocator &alloc = Allocator())
+      : tail_(0),
+        cached_head_(0),
+        head_(0),
+        cached_tail_(0),
+        storage_(capacity, alloc) {}
+  spsc_ring(const spsc_ring &) = delete;
+  spsc_ring &operator=(const spsc_ring &) = delete;
+
+  size_type capacity() const noexcept { return storage_.Capacity(); }
+
+  // Number of readable elements at some moment during the call.
+  size_type size_approx() const noexcept {
+    size_type head = head_.load(std::memory_order_relaxed);
+    return tail_.load(std::memory_order_relaxed) - head;
+  }
+
+  // Producer side
+
+  // Up to count free contiguous slots, empty if the ring is full.
+  span<T> reserve(size_type count) noexcept {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    size_type free = capacity() - (tail - cached_head_);
+    if (free < count) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      free = capacity() - (tail - cached_head_);
+    }
+    size_type offset = tail % capacity();
+    return {storage_.Data() + offset,
+            std::min({count, free, capacity() - offset})};
+  }
+
+  // Publishes the first count slots of the last reserved span.
+  void commit(size_type count) noexcept {
+    tail_.store(tail_.load(std::memory_order_relaxed) + count,
+                std::memory_order_release);
+  }
+
+  bool try_push(const T &value) { return try_emplace(value); }
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+  template <typename U>
+  bool try_emplace(U &&value) {
+    span<T> slot = reserve(1);
+    if (slot.empty()) {
+      return false;
+    }
+    slot.front() = std::forward<U>(value);
+    commit(1);
+    return true;
+  }
+
+  // Consumer side
+
+  // Up to count readable contiguous elements, empty if the ring is empty.
+  span<T> peek(
+      size_type count = std::numeric_limits<size_type>::max()) noexcept {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (cached_tail_ - head < count) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    size_type offset = head % capacity();
+    return {storage_.Data() + offset,
+            std::min({count, cached_tail_ - head, capacity() - offset})};
+  }
+
+  // Frees the first count elements of the last peeked span.
+  void release(size_type count) noexcept {
+    head_.store(head_.load(std::memory_order_relaxed) + count,
+                std::memory_order_release);
+  }
+
+  bool try_pop(T &value) {
+    span<T> slot = peek(1);
+    if (slot.empty()) {
+      return false;
+    }
+    value = std::move(slot.front());
+    release(1);
+    return true;
+  }
+
+ private:
+  // Positions only grow, slot of position p is p % capacity().
+  // Producer state
+  alignas(spsc_ring_internal::kCacheLineSize) std::atomic<size_type> tail_;
+  size_type cached_head_;
+  // Consumer state
+  alignas(spsc_ring_internal::kCacheLineSize) std::atomic<size_type> head_;
+  size_type cached_tail_;
+  alignas(spsc_ring_internal::kCacheLineSize)
+      spsc_ring_internal::RingStorage<T, N, Allocator> storage_;
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_SPSC_RING_H
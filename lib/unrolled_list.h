@@ -0,0 +1,530 @@
+#if !defined(CONTAINERS_LIB_UNROLLED_LIST_H)
+#define CONTAINERS_LIB_UNROLLED_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "list.h"
+
+namespace dizing {
+
+namespace unrolled_list_internal {
+
+using list_internal::BaseListNode;
+
+// Elements of a node fit into about four cache lines, at least 4.
+template <typename T>
+constexpr std::size_t DefaultNodeCapacity() {
+  constexpr std::size_t kNodeBytes = 256;
+  constexpr std::size_t kHeaderBytes =
+      sizeof(BaseListNode) + sizeof(std::size_t);
+  return std::max<std::size_t>(4, (kNodeBytes - kHeaderBytes) / sizeof(T));
+}
+
+// Node with up to K elements stored contiguously in [0, count_).
+template <typename T, std::size_t K>
+struct UnrolledNode : public BaseListNode {
+  std::size_t count_;
+  alignas(T) unsigned char storage_[K * sizeof(T)];
+
+  T *Data() noexcept { return reinterpret_cast<T *>(storage_); }
+  const T *Data() const noexcept {
+    return reinterpret_cast<const T *>(storage_);
+  }
+};
+
+// Element index_ of node node_, end is index 0 of the fake node.
+template <typename T, std::size_t K, bool isConst>
+class UnrolledIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+  using reference =
+      typename std::conditional_t<isConst, const value_type &, value_type &>;
+  using pointer =
+      typename std::conditional_t<isConst, const value_type *, value_type *>;
+  using base_node_pointer =
+      typename std::conditional_t<isConst, const BaseListNode *,
+                                  BaseListNode *>;
+  using node_pointer =
+      typename std::conditional_t<isConst, const UnrolledNode<T, K> *,
+                                  UnrolledNode<T, K> *>;
+
+  UnrolledIterator(base_node_pointer node, std::size_t index) noexcept
+      : node_(node), index_(index) {}
+
+  // Non const to const
+  template <
+      bool otherIsConst,
+      std::enable_if_t<isConst == true && otherIsConst == false, bool> = true>
+  UnrolledIterator(const UnrolledIterator<T, K, otherIsConst> &other) noexcept
+      : node_(other.GetNode()), index_(other.GetIndex()) {}
+
+  UnrolledIterator &operator++() {
+    if (++index_ == Node()->count_) {
+      node_ = node_->next_;
+      index_ = 0;
+    }
+    return *this;
+  }
+  UnrolledIterator operator++(int) {
+    UnrolledIterator temp(*this);
+    ++(*this);
+    return temp;
+  }
+  UnrolledIterator &operator--() {
+    if (index_ == 0) {
+      node_ = node_->prev_;
+      index_ = Node()->count_;
+    }
+    --index_;
+    return *this;
+  }
+  UnrolledIterator operator--(int) {
+    UnrolledIterator temp(*this);
+    --(*this);
+    return temp;
+  }
+  reference operator*() const { return Node()->Data()[index_]; }
+  pointer operator->() const { return &**this; }
+
+  base_node_pointer GetNode() const noexcept { return node_; }
+  std::size_t GetIndex() const noexcept { return index_; }
+  bool operator==(const UnrolledIterator &other) const {
+    return node_ == other.node_ && index_ == other.index_;
+  }
+  bool operator!=(const UnrolledIterator &other) const {
+    return !(*this == other);
+  }
+
+ private:
+  base_node_pointer node_;
+  std::size_t index_;
+
+  node_pointer Node() const noexcept {
+    return static_cast<node_pointer>(node_);
+  }
+};
+
+}  // namespace unrolled_list_internal
+
+// Doubly linked list of nodes holding up to K elements each: links cost
+// 16 bytes per node instead of per element and traversal touches adjacent
+// elements. A full node is split in halves on insertion, a node is merged
+// with the next one when both fit into half a node after erasure.
+// Insertion and erasure invalidate iterators and references to elements of
+// the touched nodes; whole nodes are relinked by splice without copies.
+template <typename T,
+          std::size_t K = unrolled_list_internal::DefaultNodeCapacity<T>(),
+          typename Allocator = std::allocator<T>>
+class unrolled_list {
+  static_assert(K >= 2, "nodes must hold at least two elements");
+
+ public:
+  using value_type = T;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = unrolled_list_internal::UnrolledIterator<T, K, false>;
+  using const_iterator = unrolled_list_internal::UnrolledIterator<T, K, true>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using base_node = list_internal::BaseListNode;
+  using node = unrolled_list_internal::UnrolledNode<value_type, K>;
+  using value_traits = std::allocator_traits<Allocator>;
+  using node_alloc = typename value_traits::template rebind_alloc<node>;
+  using node_traits = typename value_traits::template rebind_traits<node>;
+
+  static constexpr size_type kNodeCapacity = K;
+
+  // Constructors
+
+  unrolled_list() : unrolled_list(Allocator()) {}
+
+  explicit unrolled_list(const Allocator &alloc)
+      : node_alloc_(alloc),
+        val_alloc_(alloc),
+        size_(0),
+        fakeNode_({&fakeNode_, &fakeNode_}) {}
+
+  // Delegating constructors: once unrolled_list(alloc) is done, the
+  // destructor frees already created nodes if the rest throws.
+  explicit unrolled_list(size_type n, const Allocator &alloc = Allocator())
+      : unrolled_list(alloc) {
+    for (size_type i = 0; i < n; ++i) {
+      emplace_back();
+    }
+  }
+
+  template <typename Iter,
+            typename = typename std::iterator_traits<Iter>::iterator_category>
+  unrolled_list(Iter first, Iter last, const Allocator &alloc = Allocator())
+      : unrolled_list(alloc) {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  unrolled_list(std::initializer_list<value_type> items,
+                const Allocator &alloc = Allocator())
+      : unrolled_list(items.begin(), items.end(), alloc) {}
+
+  unrolled_list(const unrolled_list &other)
+      : unrolled_list(other,
+                      value_traits::select_on_container_copy_construction(
+                          other.val_alloc_)) {}
+
+  unrolled_list(const unrolled_list &other, const Allocator &alloc)
+      : unrolled_list(other.begin(), other.end(), alloc) {}
+
+  unrolled_list(unrolled_list &&other) noexcept
+      : node_alloc_(std::move(other.node_alloc_)),
+        val_alloc_(std::move(other.val_alloc_)),
+        size_(other.size_),
+        fakeNode_({&fakeNode_, &fakeNode_}) {
+    if (other.size_ > 0) {
+      fakeNode_.HookBefore(&other.fakeNode_);
+      other.fakeNode_.Unhook();
+      other.size_ = 0;
+    }
+  }
+
+  // Nodes are stolen if allocators are equal, otherwise elements are moved
+  // into new nodes.
+  unrolled_list(unrolled_list &&other, const Allocator &alloc)
+      : unrolled_list(alloc) {
+    MoveElementsFrom(other);
+  }
+
+  ~unrolled_list() { clear(); }
+
+  // Strong exception safety: elements are copied into a new list first.
+  // The allocator of other is taken if it propagates on copy assignment.
+  unrolled_list &operator=(const unrolled_list &other) {
+    if (this != &other) {
+      constexpr bool kPropagate =
+          value_traits::propagate_on_container_copy_assignment::value;
+      unrolled_list copy(other, kPropagate ? other.val_alloc_ : val_alloc_);
+      clear();
+      if constexpr (kPropagate) {
+        node_alloc_ = other.node_alloc_;
+        val_alloc_ = other.val_alloc_;
+      }
+      splice(end(), copy);
+    }
+    return *this;
+  }
+
+  // O(1) if the allocator propagates or both allocators are equal, otherwise
+  // elements are moved one by one into nodes of our allocator.
+  unrolled_list &operator=(unrolled_list &&other) noexcept(
+      value_traits::propagate_on_container_move_assignment::value ||
+      value_traits::is_always_equal::value) {
+    if (this != &other) {
+      clear();
+      if constexpr (value_traits::propagate_on_container_move_assignment::
+                        value) {
+        node_alloc_ = other.node_alloc_;
+        val_alloc_ = other.val_alloc_;
+      }
+      MoveElementsFrom(other);
+    }
+    return *this;
+  }
+
+  Allocator get_allocator() const { return val_alloc_; }
+
+  // Element Access
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *(--end()); }
+  const_reference back() const { return *(--end()); }
+
+  // Iterators
+  iterator begin() { return iterator(fakeNode_.next_, 0); }
+  iterator end() { return iterator(&fakeNode_, 0); }
+  const_iterator begin() const { return const_iterator(fakeNode_.next_, 0); }
+  const_iterator end() const { return const_iterator(&fakeNode_, 0); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // Capacity
+  bool empty() const { return size() == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const { return value_traits::max_size(val_alloc_); }
+  // Number of nodes, linear.
+  size_type node_count() const {
+    size_type count = 0;
+    for (const base_node *it = fakeNode_.next_; it != &fakeNode_;
+         it = it->next_) {
+      ++count;
+    }
+    return count;
+  }
+
+  // Modifiers
+
+  // Inserts into the node of pos, or the previous node when pos is the
+  // first element of its node. A full node is split first; if args refer
+  // to its elements, the new element is constructed in a temporary before
+  // the split moves them.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    base_node_pointer base = IteratorConstCast(pos).GetNode();
+    size_type index = pos.GetIndex();
+    node_pointer target = nullptr;
+    if (index == 0 && base->prev_ != &fakeNode_ &&
+        AsNode(base->prev_)->count_ < K) {
+      target = AsNode(base->prev_);
+      index = target->count_;
+    } else if (base == &fakeNode_) {
+      node_pointer created = CreateNode(base);
+      try {
+        ConstructInNode(created, 0, std::forward<Args>(args)...);
+      } catch (...) {
+        DestroyNode(created);
+        throw;
+      }
+      ++size_;
+      return iterator(created, 0);
+    } else {
+      target = AsNode(base);
+      if (target->count_ == K) {
+        if ((IsInNode(target, std::addressof(args)) || ...)) {
+          value_type temp(std::forward<Args>(args)...);
+          return emplace(pos, std::move(temp));
+        }
+        SplitNode(target, K / 2);
+        if (index > K / 2) {
+          target = AsNode(target->next_);
+          index -= K / 2;
+        }
+      }
+    }
+    ConstructInNode(target, index, std::forward<Args>(args)...);
+    ++size_;
+    return iterator(target, index);
+  }
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  iterator erase(const_iterator pos) {
+    node_pointer target = AsNode(IteratorConstCast(pos).GetNode());
+    size_type index = pos.GetIndex();
+    T *data = target->Data();
+    std::move(data + index + 1, data + target->count_, data + index);
+    value_traits::destroy(val_alloc_, data + target->count_ - 1);
+    --target->count_;
+    --size_;
+    if (target->count_ == 0) {
+      base_node_pointer next = target->next_;
+      DestroyNode(target);
+      return iterator(next, 0);
+    }
+    MergeNextInto(target);
+    if (index == target->count_) {
+      return iterator(target->next_, 0);
+    }
+    return iterator(target, index);
+  }
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type count = 0;
+    for (const_iterator it = first; it != last; ++it) {
+      ++count;
+    }
+    iterator it = IteratorConstCast(first);
+    for (size_type i = 0; i < count; ++i) {
+      it = erase(it);
+    }
+    return it;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+  void pop_back() { erase(--end()); }
+
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+  }
+  void pop_front() { erase(begin()); }
+
+  void clear() {
+    while (fakeNode_.next_ != &fakeNode_) {
+      DestroyNode(AsNode(fakeNode_.next_));
+    }
+    size_ = 0;
+  }
+
+  // Allocators are exchanged only if they propagate on swap, otherwise they
+  // must be equal.
+  void swap(unrolled_list &other) {
+    if constexpr (value_traits::propagate_on_container_swap::value) {
+      std::swap(node_alloc_, other.node_alloc_);
+      std::swap(val_alloc_, other.val_alloc_);
+    }
+    std::swap(size_, other.size_);
+    base_node::swap(fakeNode_, other.fakeNode_);
+  }
+
+  // Relinks all nodes of other before pos without copies or allocations,
+  // except for splitting the node of pos if pos isn't its first element.
+  // Allocators of both lists must be equal.
+  void splice(const_iterator pos, unrolled_list &other) {
+    splice(pos, std::move(other));
+  }
+
+  void splice(const_iterator pos, unrolled_list &&other) {
+    if (&other == this || other.empty()) {
+      return;
+    }
+    base_node_pointer base = IteratorConstCast(pos).GetNode();
+    if (pos.GetIndex() != 0) {
+      SplitNode(AsNode(base), pos.GetIndex());
+      base = base->next_;
+    }
+    base_node::Transfer(base, other.fakeNode_.next_, &other.fakeNode_);
+    size_ += other.size_;
+    other.size_ = 0;
+  }
+
+ private:
+  using node_pointer = node *;
+  using base_node_pointer = base_node *;
+
+  node_alloc node_alloc_;
+  Allocator val_alloc_;
+  size_type size_;
+  base_node fakeNode_;
+
+  static node_pointer AsNode(base_node_pointer base) noexcept {
+    return static_cast<node_pointer>(base);
+  }
+
+  // Allocates an empty node and hooks it before pos.
+  node_pointer CreateNode(base_node_pointer pos) {
+    node_pointer created = node_traits::allocate(node_alloc_, 1);
+    created->count_ = 0;
+    created->HookBefore(pos);
+    return created;
+  }
+
+  // Destroys elements of the node, unhooks and frees it.
+  void DestroyNode(node_pointer target) noexcept {
+    T *data = target->Data();
+    for (size_type i = 0; i < target->count_; ++i) {
+      value_traits::destroy(val_alloc_, data + i);
+    }
+    target->Unhook();
+    node_traits::deallocate(node_alloc_, target, 1);
+  }
+
+  // True if p points inside storage of an element of target.
+  static bool IsInNode(node_pointer target, const void *p) {
+    auto bytes = static_cast<const unsigned char *>(p);
+    auto first = reinterpret_cast<const unsigned char *>(target->Data());
+    auto last = reinterpret_cast<const unsigned char *>(target->Data() + K);
+    return std::less_equal<const unsigned char *>()(first, bytes) &&
+           std::less<const unsigned char *>()(bytes, last);
+  }
+
+  // Constructs element at index of a node which isn't full. The element is
+  // created at the end and rotated into place.
+  template <typename... Args>
+  void ConstructInNode(node_pointer target, size_type index, Args &&...args) {
+    T *data = target->Data();
+    value_traits::construct(val_alloc_, data + target->count_,
+                            std::forward<Args>(args)...);
+    ++target->count_;
+    std::rotate(data + index, data + target->count_ - 1,
+                data + target->count_);
+  }
+
+  // Moves elements [from, count_) to the end of destination. Elements are
+  // copied if their move may throw, so on exception both nodes are left as
+  // they were.
+  void MoveTail(node_pointer source, size_type from,
+                node_pointer destination) {
+    T *data = source->Data();
+    size_type old_count = destination->count_;
+    try {
+      for (size_type i = from; i < source->count_; ++i) {
+        value_traits::construct(val_alloc_,
+                                destination->Data() + destination->count_,
+                                std::move_if_noexcept(data[i]));
+        ++destination->count_;
+      }
+    } catch (...) {
+      while (destination->count_ > old_count) {
+        --destination->count_;
+        value_traits::destroy(val_alloc_,
+                              destination->Data() + destination->count_);
+      }
+      throw;
+    }
+    while (source->count_ > from) {
+      --source->count_;
+      value_traits::destroy(val_alloc_, data + source->count_);
+    }
+  }
+
+  // Moves elements [at, count_) into a new node after target.
+  void SplitNode(node_pointer target, size_type at) {
+    node_pointer created = CreateNode(target->next_);
+    try {
+      MoveTail(target, at, created);
+    } catch (...) {
+      DestroyNode(created);
+      throw;
+    }
+  }
+
+  // Merges the next node into target if both fit into half a node.
+  void MergeNextInto(node_pointer target) {
+    base_node_pointer next = target->next_;
+    if (next != &fakeNode_ && target->count_ + AsNode(next)->count_ <= K / 2) {
+      MoveTail(AsNode(next), 0, target);
+      DestroyNode(AsNode(next));
+    }
+  }
+
+  // Appends elements of other, other becomes empty. Nodes are relinked if
+  // allocators are equal, otherwise elements are moved into new nodes.
+  void MoveElementsFrom(unrolled_list &other) {
+    if (val_alloc_ == other.val_alloc_) {
+      splice(end(), other);
+    } else {
+      for (auto &element : other) {
+        emplace_back(std::move(element));
+      }
+      other.clear();
+    }
+  }
+
+  // Const cast from const iterator to non-const iterator
+  iterator IteratorConstCast(const_iterator pos) const {
+    return iterator(const_cast<base_node_pointer>(pos.GetNode()),
+                    pos.GetIndex());
+  }
+};
+
+}  // namespace dizing
+
+#endif  // CONTAINERS_LIB_UNROLLED_LIST_H
@@ -1,13 +1,56 @@
 #if !defined(CONTAINERS_LIB_VECTOR_H)
 #define CONTAINERS_LIB_VECTOR_H
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <type_traits>
+
+#include "growth_policy.h"
 
 namespace dizing {
 
-template <typename T, typename Allocator = std::allocator<T>>
-class vector {
+// Types for which moving an object to a new address and forgetting the old
+// one is equivalent to memcpy. Containers relocate such elements in bulk.
+// Trivially copyable types qualify automatically, other types (for example
+// ones holding a unique_ptr) can opt in by specialization.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+namespace vector_internal {
+
+// Storage for first InlineCapacity elements inside the vector object.
+template <typename T, std::size_t InlineCapacity>
+class InlineBuffer {
+ protected:
+  T *InlineData() noexcept { return reinterpret_cast<T *>(storage_); }
+
+ private:
+  alignas(T) unsigned char storage_[InlineCapacity * sizeof(T)];
+};
+
+// No inline storage: empty data is nullptr.
+template <typename T>
+class InlineBuffer<T, 0> {
+ protected:
+  T *InlineData() noexcept { return nullptr; }
+};
+
+}  // namespace vector_internal
+
+// GrowthPolicy decides capacity of reallocated buffer, see growth_policy.h.
+// Up to InlineCapacity elements are stored inside the object without heap
+// allocation, see small_vector.h.
+template <typename T, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = doubling_growth<>,
+          std::size_t InlineCapacity = 0>
+class vector : private vector_internal::InlineBuffer<T, InlineCapacity> {
  public:
   using value_type = T;
   using reference = T &;
@@ -17,90 +60,276 @@ class vector {
   using iterator = pointer;
   using const_iterator = const_pointer;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
   using alloc_traits = std::allocator_traits<Allocator>;
 
-  vector() : data_(nullptr), capacity_(0), size_(0), alloc_(Allocator()) {}
+  vector()
+      : data_(this->InlineData()),
+        capacity_(InlineCapacity),
+        size_(0),
+        alloc_(Allocator()) {}
+
+  explicit vector(const Allocator &alloc) noexcept
+      : data_(this->InlineData()),
+        capacity_(InlineCapacity),
+        size_(0),
+        alloc_(alloc) {}
+
+  // count value-initialized elements
+  explicit vector(size_type count, const Allocator &alloc = Allocator())
+      : vector(alloc) {
+    resize(count);
+  }
 
-  template <typename Iter>
-  vector(Iter beg, Iter end) : vector() {
-    size_type input_size = static_cast<size_type>(std::distance(beg, end));
-    reserve(input_size);
-    size_ = input_size;
-    for (size_type i = 0; i < input_size; ++i) {
-      CreateElement(&data_[i], *beg);
-      ++beg;
-    }
+  vector(size_type count, const_reference value,
+         const Allocator &alloc = Allocator())
+      : vector(alloc) {
+    assign(count, value);
   }
 
-  vector(std::initializer_list<value_type> const &items)
-      : vector(items.begin(), items.end()) {}
+  template <typename Iter,
+            typename = typename std::iterator_traits<Iter>::iterator_category>
+  vector(Iter beg, Iter end, const Allocator &alloc = Allocator())
+      : vector(alloc) {
+    assign(beg, end);
+  }
+
+  vector(std::initializer_list<value_type> const &items,
+         const Allocator &alloc = Allocator())
+      : vector(items.begin(), items.end(), alloc) {}
+
+  vector(const vector &other)
+      : vector(other, alloc_traits::select_on_container_copy_construction(
+                          other.alloc_)) {}
+
+  vector(const vector &other, const Allocator &alloc)
+      : vector(other.begin(), other.end(), alloc) {}
+
+  // Steals the buffer, other is left empty.
+  // Inline elements can't be stolen, they are moved one by one.
+  vector(vector &&other) noexcept(kNothrowTakeStorage)
+      : data_(this->InlineData()),
+        capacity_(InlineCapacity),
+        size_(0),
+        alloc_(std::move(other.alloc_)) {
+    TakeStorage(other);
+  }
 
-  vector(const vector &other) : vector(other.begin(), other.end()) {}
+  // Steals the buffer if allocators are equal, otherwise elements are moved
+  // one by one.
+  vector(vector &&other, const Allocator &alloc) : vector(alloc) {
+    if (alloc_ == other.alloc_) {
+      TakeStorage(other);
+    } else {
+      MoveElementsFrom(other);
+    }
+  }
 
   ~vector() { freeDataArray(data_, capacity_, size_); }
 
+  // Existing elements are assigned to, the buffer is reused if it is large
+  // enough. The allocator of other is taken if it propagates on copy
+  // assignment, memory of the old one is freed first if they differ.
   vector &operator=(const vector &other) {
     if (this != &other) {
-      vector(other).swap(*this);
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (alloc_ != other.alloc_) {
+          ResetStorage();
+        }
+        alloc_ = other.alloc_;
+      }
+      assign(other.begin(), other.end());
     }
     return *this;
   }
 
-  vector &operator=(vector &&other) {
+  // O(1) if the allocator propagates or both allocators are equal (and
+  // other isn't stored inline). Otherwise memory of other can't be freed by
+  // our allocator, so elements are moved one by one.
+  vector &operator=(vector &&other) noexcept(
+      (alloc_traits::propagate_on_container_move_assignment::value ||
+       alloc_traits::is_always_equal::value) &&
+      kNothrowTakeStorage) {
     if (this != &other) {
-      vector(std::move(other)).swap(*this);
+      if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                        value) {
+        ResetStorage();
+        alloc_ = other.alloc_;
+        TakeStorage(other);
+      } else if (alloc_ == other.alloc_) {
+        ResetStorage();
+        TakeStorage(other);
+      } else {
+        clear();
+        MoveElementsFrom(other);
+      }
     }
     return *this;
   }
 
-  void push_back(T &&value) {
-    AutomaticReserveLogic();
-    CreateElement(&data_[size_], std::move(value));
-    ++size_;
+  // Replaces contents. Existing elements are assigned to, the buffer is
+  // reallocated only if count exceeds capacity.
+  void assign(size_type count, const_reference value) {
+    AssignElements(count, [&](pointer slot, size_type, bool construct) {
+      PutElement(slot, construct, value);
+    });
+  }
+  // Range must not refer to elements of this vector.
+  template <typename Iter,
+            typename = typename std::iterator_traits<Iter>::iterator_category>
+  void assign(Iter first, Iter last) {
+    using category = typename std::iterator_traits<Iter>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      size_type count = static_cast<size_type>(std::distance(first, last));
+      // Fill requests go in ascending order, one per element
+      AssignElements(count, [&](pointer slot, size_type, bool construct) {
+        PutElement(slot, construct, *first);
+        ++first;
+      });
+    } else {
+      clear();
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    }
+  }
+  void assign(std::initializer_list<value_type> const &items) {
+    assign(items.begin(), items.end());
   }
 
-  void push_back(const T &value) {
-    AutomaticReserveLogic();
-    CreateElement(&data_[size_], value);
-    ++size_;
-  };
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void push_back(const T &value) { emplace_back(value); };
+
+  // Constructs element from args directly in the buffer.
+  // Args may refer to elements of this vector even if it reallocates.
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ < capacity_) {
+      CreateElement(data_ + size_, std::forward<Args>(args)...);
+      ++size_;
+    } else {
+      ReallocatingInsert(size_, 1, [&](pointer slot, size_type, bool) {
+        CreateElement(slot, std::forward<Args>(args)...);
+      });
+    }
+    return data_[size_ - 1];
+  }
+
+  // Constructs element from args before pos. If pos isn't the end, the new
+  // element is constructed in a temporary and moved into the shifted slot.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    if ((IsOwnElement(std::addressof(args)) || ...)) {
+      value_type temp(std::forward<Args>(args)...);
+      return insert(pos, std::move(temp));
+    }
+    return InsertElements(IndexOf(pos), 1, [&](pointer slot, size_type,
+                                               bool construct) {
+      PutElement(slot, construct, std::forward<Args>(args)...);
+    });
+  }
+
+  // Elements after pos are shifted in place, the buffer is reallocated only
+  // if capacity is exceeded.
   iterator insert(const_iterator pos, const_reference value) {
-    return InsertElement(pos, value);
+    if (IsOwnElement(std::addressof(value))) {
+      value_type copy(value);
+      return insert(pos, std::move(copy));
+    }
+    return InsertElements(IndexOf(pos), 1, [&](pointer slot, size_type,
+                                               bool construct) {
+      PutElement(slot, construct, value);
+    });
   }
   iterator insert(const_iterator pos, value_type &&value) {
-    return InsertElement(pos, std::move(value));
+    return InsertElements(IndexOf(pos), 1, [&](pointer slot, size_type,
+                                               bool construct) {
+      PutElement(slot, construct, std::move(value));
+    });
   }
-
-  void erase(iterator pos) {
-    size_type before_erase_count =
-        static_cast<size_type>(std::distance(begin(), pos));
-    size_type after_erase_count =
-        static_cast<size_type>(std::distance(pos, end()));
-    pointer new_data = alloc_traits::allocate(alloc_, capacity_);
-
-    ConstructElementsFromAnotherData(before_erase_count, data_, new_data);
-    ConstructElementsFromAnotherData(after_erase_count - 1,
-                                     data_ + before_erase_count + 1,
-                                     new_data + before_erase_count);
-    freeDataArray(data_, capacity_, size_);
-    data_ = new_data;
-    --size_;
+  iterator insert(const_iterator pos, size_type count,
+                  const_reference value) {
+    if (IsOwnElement(std::addressof(value))) {
+      value_type copy(value);
+      return insert(pos, count, copy);
+    }
+    return InsertElements(IndexOf(pos), count, [&](pointer slot, size_type,
+                                                   bool construct) {
+      PutElement(slot, construct, value);
+    });
+  }
+  // Range must not refer to elements of this vector.
+  template <typename Iter,
+            typename = typename std::iterator_traits<Iter>::iterator_category>
+  iterator insert(const_iterator pos, Iter first, Iter last) {
+    using category = typename std::iterator_traits<Iter>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      size_type count = static_cast<size_type>(std::distance(first, last));
+      // Fill requests go in two ascending runs, so the cursor restarts once
+      Iter cursor = first;
+      size_type cursor_index = 0;
+      return InsertElements(
+          IndexOf(pos), count,
+          [&](pointer slot, size_type index, bool construct) {
+            if (index < cursor_index) {
+              cursor = first;
+              cursor_index = 0;
+            }
+            std::advance(cursor,
+                         static_cast<typename std::iterator_traits<
+                             Iter>::difference_type>(index - cursor_index));
+            cursor_index = index;
+            PutElement(slot, construct, *cursor);
+          });
+    } else {
+      // Single pass range: its size is unknown, so it is buffered first
+      vector buffer(alloc_);
+      for (; first != last; ++first) {
+        buffer.push_back(*first);
+      }
+      return insert(pos, std::make_move_iterator(buffer.begin()),
+                    std::make_move_iterator(buffer.end()));
+    }
+  }
+  iterator insert(const_iterator pos,
+                  std::initializer_list<value_type> const &items) {
+    return insert(pos, items.begin(), items.end());
   }
 
+  // Following elements are moved to the left in place.
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type index = IndexOf(first);
+    size_type count = static_cast<size_type>(std::distance(first, last));
+    if (count > 0) {
+      pointer gap = data_ + index;
+      size_type tail_count = size_ - index - count;
+      if constexpr (is_trivially_relocatable_v<value_type>) {
+        DestroyElements(gap, count);
+        ShiftBytes(gap + count, gap, tail_count);
+      } else {
+        std::move(gap + count, data_ + size_, gap);
+        DestroyElements(gap + tail_count, count);
+      }
+      size_ -= count;
+    }
+    return data_ + index;
+  }
   void pop_back() {
     alloc_traits::destroy(alloc_, data_ + size_ - 1);
     --size_;
   }
 
   void clear() {
-    if (data_ != nullptr) {
-      for (size_type i = 0; i < size_; ++i) {
-        alloc_traits::destroy(alloc_, data_ + i);
-      }
-    }
+    DestroyElements(data_, size_);
     size_ = 0;
   }
 
+  Allocator get_allocator() const { return alloc_; }
+
   // ELEMENT ACCESS
   reference at(size_type pos) {
     if (!(pos < size_)) {
@@ -145,7 +374,7 @@ class vector {
   void reserve(size_type new_capacity) {
     if (new_capacity > capacity_) {
       pointer new_data = MoveToNewDataArray(new_capacity, size_, data_);
-      freeDataArray(data_, capacity_, size_);
+      freeDataArray(data_, capacity_, 0);
       data_ = new_data;
       capacity_ = new_capacity;
     }
@@ -153,49 +382,120 @@ class vector {
 
   size_type capacity() const { return capacity_; }
 
+  // New elements are value-initialized
+  void resize(size_type count) {
+    if (count < size_) {
+      erase(begin() + count, end());
+    } else {
+      InsertElements(size_, count - size_, [&](pointer slot, size_type, bool) {
+        CreateElement(slot);
+      });
+    }
+  }
+
+  void resize(size_type count, const_reference value) {
+    if (count < size_) {
+      erase(begin() + count, end());
+    } else {
+      insert(cend(), count - size_, value);
+    }
+  }
+
+  // Same as resize, but new elements are default-initialized: for trivial
+  // types the memory is left as is, so the buffer can be filled through
+  // data() without zeroing it first. Other types are value-initialized.
+  void resize_default_init(size_type count) {
+    if (count < size_) {
+      erase(begin() + count, end());
+    } else {
+      append_uninitialized(count - size_);
+    }
+  }
+
+  // Appends count default-initialized elements (see resize_default_init).
+  // Returns pointer to the first of them.
+  pointer append_uninitialized(size_type count) {
+    if (capacity_ - size_ < count) {
+      reserve(GrownCapacity(size_ + count));
+    }
+    pointer first = data_ + size_;
+    if constexpr (std::is_trivially_default_constructible_v<value_type>) {
+      size_ += count;
+    } else {
+      for (size_type i = 0; i < count; ++i) {
+        CreateElement(first + i);
+        ++size_;
+      }
+    }
+    return first;
+  }
+
+  // Elements that fit into inline storage are moved back there.
   void shrink_to_fit() {
+    if (IsInline(data_)) {
+      return;
+    }
+    if (size_ <= InlineCapacity) {
+      RelocateElements(size_, data_, this->InlineData());
+      freeDataArray(data_, capacity_, 0);
+      data_ = this->InlineData();
+      capacity_ = InlineCapacity;
+      return;
+    }
     pointer new_data = MoveToNewDataArray(size_, size_, data_);
-    freeDataArray(data_, capacity_, size_);
+    freeDataArray(data_, capacity_, 0);
     data_ = new_data;
     capacity_ = size_;
   };
 
+  // O(1) unless one of vectors is stored inline.
+  // Allocators are exchanged only if they propagate on swap, otherwise they
+  // must be equal.
   void swap(vector &other) {
+    if (IsInline(data_) || other.IsInline(other.data_)) {
+      vector temp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(temp);
+      return;
+    }
     std::swap(data_, other.data_);
     std::swap(capacity_, other.capacity_);
-    std::swap(alloc_, other.alloc_);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
     std::swap(size_, other.size_);
   }
 
+  // Inserts one element per argument before pos, the tail is shifted once.
+  // Each argument is either a value_type or a constructor argument of it.
   template <class... Args>
   iterator insert_many(const_iterator pos, Args &&...args) {
-    static_assert(
-        (std::is_same_v<value_type, std::remove_reference_t<decltype(args)>> &&
-         ...));
-    size_type before_insert_count =
-        static_cast<size_type>(std::distance(cbegin(), pos));
-    size_type after_insert_count =
-        static_cast<size_type>(std::distance(pos, cend()));
-    reserve(capacity_ + sizeof...(args));
-    pointer new_data = alloc_traits::allocate(alloc_, capacity_);
-    ConstructElementsFromAnotherData(before_insert_count, data_, new_data);
-    ConstructElementsFromAnotherData(
-        after_insert_count, data_ + before_insert_count,
-        new_data + before_insert_count + sizeof...(args));
-    size_type tmp = before_insert_count - 1;
-    (CreateElement(new_data + ++tmp, std::forward<Args>(args)), ...);
-    freeDataArray(data_, capacity_, size_);
-    data_ = new_data;
-    size_ += sizeof...(args);
-    return data_ + before_insert_count;
+    static_assert((std::is_constructible_v<value_type, Args &&> && ...));
+    size_type index = IndexOf(pos);
+    if constexpr (sizeof...(args) == 0) {
+      return data_ + index;
+    } else {
+      auto fill = [&](pointer slot, size_type slot_index, bool construct) {
+        size_type i = 0;
+        ((i++ == slot_index
+              ? PutElement(slot, construct, std::forward<Args>(args))
+              : void()),
+         ...);
+      };
+      // In place shifting would move arguments referring to own elements
+      // before they are read, so they are read into a new buffer instead.
+      if ((IsOwnElement(std::addressof(args)) || ...)) {
+        ReallocatingInsert(index, sizeof...(args), fill);
+        return data_ + index;
+      }
+      return InsertElements(index, sizeof...(args), fill);
+    }
   }
 
   template <class... Args>
   void insert_many_back(Args &&...args) {
-    static_assert(
-        (std::is_same_v<value_type, std::remove_reference_t<decltype(args)>> &&
-         ...));
-    (push_back(std::forward<Args>(args)), ...);
+    static_assert((std::is_constructible_v<value_type, Args &&> && ...));
+    insert_many(cend(), std::forward<Args>(args)...);
   }
 
  private:
@@ -204,19 +504,66 @@ class vector {
   size_type size_;
   Allocator alloc_;
 
+  static constexpr bool kNothrowTakeStorage =
+      InlineCapacity == 0 || std::is_nothrow_move_constructible_v<value_type>;
+
+  bool IsInline(const_pointer data_array) noexcept {
+    return data_array == this->InlineData();
+  }
+
+  // Destroys elements and frees memory, vector becomes empty with inline
+  // capacity.
+  void ResetStorage() noexcept {
+    freeDataArray(data_, capacity_, size_);
+    data_ = this->InlineData();
+    capacity_ = InlineCapacity;
+    size_ = 0;
+  }
+
+  // Takes elements of other while this is empty with inline capacity.
+  // Heap buffer is stolen, inline elements are moved one by one.
+  // Other is left empty.
+  void TakeStorage(vector &other) noexcept(kNothrowTakeStorage) {
+    // Without inline buffer "inline" data is an empty null buffer
+    if (InlineCapacity > 0 && other.IsInline(other.data_)) {
+      RelocateElements(other.size_, other.data_, data_);
+      size_ = other.size_;
+      other.size_ = 0;
+    } else {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.data_ = other.InlineData();
+      other.capacity_ = InlineCapacity;
+      other.size_ = 0;
+    }
+  }
+
+  // Moves elements of other one by one into our buffer while this is empty,
+  // other is left empty.
+  void MoveElementsFrom(vector &other) {
+    reserve(other.size_);
+    for (size_type i = 0; i < other.size_; ++i) {
+      CreateElement(data_ + i, std::move(other.data_[i]));
+      ++size_;
+    }
+    other.clear();
+  }
+
   template <typename... Args>
   void CreateElement(pointer pos, Args &&...value) {
     alloc_traits::construct(alloc_, pos, std::forward<Args>(value)...);
   }
 
+  // Allocates new_capacity elements and relocates element_recreating_count
+  // elements there. Old elements are destroyed, old memory is left to caller.
   // if new_capacity < element_recreating_count -- UB
   pointer MoveToNewDataArray(size_type new_capacity,
                              size_type element_recreating_count,
                              pointer data_for_moving) {
     pointer new_data = alloc_traits::allocate(alloc_, new_capacity);
     try {
-      ConstructElementsFromAnotherData(element_recreating_count,
-                                       data_for_moving, new_data);
+      RelocateElements(element_recreating_count, data_for_moving, new_data);
     } catch (...) {
       alloc_traits::deallocate(alloc_, new_data, new_capacity);
       throw;
@@ -224,56 +571,246 @@ class vector {
     return new_data;
   }
 
-  void ConstructElementsFromAnotherData(size_type count, pointer data_from,
-                                        pointer data_to) {
+  // Transfers count elements from data_from to uninitialized data_to and
+  // destroys the originals.
+  void RelocateElements(size_type count, pointer data_from, pointer data_to) {
+    TransferElements(count, data_from, data_to);
+    DestroyTransferred(data_from, count);
+  }
+
+  // Transfers count elements from data_from to uninitialized data_to.
+  // Trivially relocatable elements are copied bytewise in one pass.
+  // Others are moved if the move constructor can't throw (or there is no copy
+  // constructor), otherwise copied, so on exception data_from stays untouched.
+  void TransferElements(size_type count, pointer data_from, pointer data_to) {
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      if (count > 0) {
+        std::memcpy(static_cast<void *>(data_to),
+                    static_cast<const void *>(data_from),
+                    count * sizeof(value_type));
+      }
+    } else {
+      for (size_type i = 0; i < count; ++i) {
+        try {
+          alloc_traits::construct(alloc_, data_to + i,
+                                  std::move_if_noexcept(data_from[i]));
+        } catch (...) {
+          DestroyElements(data_to, i);
+          throw;
+        }
+      }
+    }
+  }
+
+  // Finishes TransferElements: bytewise transferred elements now live at the
+  // new place and must not be destroyed.
+  void DestroyTransferred(pointer data_from, size_type count) {
+    if constexpr (!is_trivially_relocatable_v<value_type>) {
+      DestroyElements(data_from, count);
+    }
+  }
+
+  // Copies count elements bytewise, ranges may overlap.
+  static void ShiftBytes(pointer data_from, pointer data_to, size_type count) {
+    if (count > 0) {
+      std::memmove(static_cast<void *>(data_to),
+                   static_cast<const void *>(data_from),
+                   count * sizeof(value_type));
+    }
+  }
+
+  void DestroyElements(pointer first, size_type count) {
+    for (size_type i = 0; i < count; ++i) {
+      alloc_traits::destroy(alloc_, first + i);
+    }
+  }
+
+  // Move constructs count elements into uninitialized data_to.
+  // On exception already constructed ones are destroyed.
+  void MoveConstructElements(size_type count, pointer data_from,
+                             pointer data_to) {
     for (size_type i = 0; i < count; ++i) {
       try {
-        alloc_traits::construct(alloc_, data_to + i, data_from[i]);
+        CreateElement(data_to + i, std::move(data_from[i]));
       } catch (...) {
-        for (size_type j = 0; j < i; ++j) {
-          alloc_traits::destroy(alloc_, data_to + j);
-        }
+        DestroyElements(data_to, i);
         throw;
       }
     }
   }
 
+  // Destroys size elements, heap memory is deallocated.
   void freeDataArray(pointer data_array, size_type capacity, size_type size) {
-    if (data_array != nullptr) {
-      for (size_type i = 0; i < size; ++i) {
-        alloc_traits::destroy(alloc_, data_array + i);
-      }
+    DestroyElements(data_array, size);
+    if (!IsInline(data_array)) {
       alloc_traits::deallocate(alloc_, data_array, capacity);
     }
   }
 
-  void AutomaticReserveLogic() {
-    if (size_ >= capacity_) {
-      if (capacity_ == 0) {
-        reserve(1);
-      } else {
-        reserve(capacity_ * 2);
+  // Capacity of reallocated buffer that fits at least required elements.
+  size_type GrownCapacity(size_type required) const {
+    return GrowthPolicy::next_capacity(capacity_, required, sizeof(value_type));
+  }
+
+  size_type IndexOf(const_iterator pos) const {
+    return static_cast<size_type>(pos - data_);
+  }
+
+  // True if p points inside storage of an element of this vector.
+  bool IsOwnElement(const void *p) const {
+    auto bytes = static_cast<const unsigned char *>(p);
+    auto first = reinterpret_cast<const unsigned char *>(data_);
+    auto last = reinterpret_cast<const unsigned char *>(data_ + size_);
+    return std::less_equal<const unsigned char *>()(first, bytes) &&
+           std::less<const unsigned char *>()(bytes, last);
+  }
+
+  // Constructs a new element from args in uninitialized slot or assigns it to
+  // a live (moved-from) one. Assigned element is built in a temporary unless
+  // args is a single value_type.
+  template <typename... Args>
+  void PutElement(pointer slot, bool construct, Args &&...args) {
+    if (construct) {
+      CreateElement(slot, std::forward<Args>(args)...);
+    } else if constexpr (IsValueType<Args...>()) {
+      *slot = (std::forward<Args>(args), ...);
+    } else {
+      *slot = value_type(std::forward<Args>(args)...);
+    }
+  }
+
+  template <typename... Args>
+  static constexpr bool IsValueType() {
+    if constexpr (sizeof...(Args) == 1) {
+      return (std::is_same_v<value_type, std::decay_t<Args>> && ...);
+    } else {
+      return false;
+    }
+  }
+
+  // Makes vector consist of count elements.
+  // fill(slot, i, construct) is called once per element in ascending order,
+  // see PutElement. Live elements are assigned, missing ones constructed and
+  // extra ones destroyed. Buffer is rebuilt only if count exceeds capacity.
+  template <typename Filler>
+  void AssignElements(size_type count, Filler &&fill) {
+    if (count > capacity_) {
+      pointer new_data = alloc_traits::allocate(alloc_, count);
+      size_type constructed = 0;
+      try {
+        for (; constructed < count; ++constructed) {
+          fill(new_data + constructed, constructed, true);
+        }
+      } catch (...) {
+        DestroyElements(new_data, constructed);
+        alloc_traits::deallocate(alloc_, new_data, count);
+        throw;
+      }
+      freeDataArray(data_, capacity_, size_);
+      data_ = new_data;
+      capacity_ = count;
+      size_ = count;
+    } else {
+      size_type assigned = std::min(count, size_);
+      for (size_type i = 0; i < assigned; ++i) {
+        fill(data_ + i, i, false);
       }
+      for (; size_ < count; ++size_) {
+        fill(data_ + size_, size_, true);
+      }
+      DestroyElements(data_ + count, size_ - count);
+      size_ = count;
     }
   }
 
-  template <typename U>
-  iterator InsertElement(const_iterator pos, U &&value) {
-    size_type before_insert_count =
-        static_cast<size_type>(std::distance(cbegin(), pos));
-    size_type after_insert_count =
-        static_cast<size_type>(std::distance(pos, cend()));
-    AutomaticReserveLogic();
-    pointer new_data = alloc_traits::allocate(alloc_, capacity_);
-    ConstructElementsFromAnotherData(before_insert_count, data_, new_data);
-    ConstructElementsFromAnotherData(after_insert_count,
-                                     data_ + before_insert_count,
-                                     new_data + before_insert_count + 1);
-    CreateElement(new_data + before_insert_count, std::forward<U>(value));
-    freeDataArray(data_, capacity_, size_);
+  // Inserts count elements before index pos.
+  // fill(slot, i, construct) must put the i-th new element to slot, see
+  // PutElement. Arguments of fill must not refer to elements of this vector.
+  // Elements after pos are shifted right in place when capacity allows:
+  // each one is moved once, bytewise for trivially relocatable types.
+  // Strong exception guarantee when inserting at the end or reallocating,
+  // basic otherwise.
+  template <typename Filler>
+  iterator InsertElements(size_type pos, size_type count, Filler &&fill) {
+    if (count == 0) {
+      return data_ + pos;
+    }
+    if (capacity_ - size_ < count) {
+      ReallocatingInsert(pos, count, fill);
+      return data_ + pos;
+    }
+    pointer gap = data_ + pos;
+    pointer old_end = data_ + size_;
+    size_type tail_count = size_ - pos;
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      ShiftBytes(gap, gap + count, tail_count);
+      size_type constructed = 0;
+      try {
+        for (; constructed < count; ++constructed) {
+          fill(gap + constructed, constructed, true);
+        }
+      } catch (...) {
+        ShiftBytes(gap + count, gap + constructed, tail_count);
+        size_ += constructed;
+        throw;
+      }
+      size_ += count;
+    } else if (count <= tail_count) {
+      MoveConstructElements(count, old_end - count, old_end);
+      size_ += count;
+      std::move_backward(gap, old_end - count, old_end);
+      for (size_type i = 0; i < count; ++i) {
+        fill(gap + i, i, false);
+      }
+    } else {
+      // New elements past the old end are constructed before anything moves
+      size_type constructed = tail_count;
+      try {
+        for (; constructed < count; ++constructed) {
+          fill(gap + constructed, constructed, true);
+        }
+        MoveConstructElements(tail_count, gap, gap + count);
+      } catch (...) {
+        DestroyElements(old_end, constructed - tail_count);
+        throw;
+      }
+      size_ += count;
+      for (size_type i = 0; i < tail_count; ++i) {
+        fill(gap + i, i, false);
+      }
+    }
+    return gap;
+  }
+
+  // Same as InsertElements, but always builds a new buffer.
+  // New elements are constructed before old ones are touched, so arguments
+  // may refer to elements of this vector.
+  template <typename Filler>
+  void ReallocatingInsert(size_type pos, size_type count, Filler &&fill) {
+    size_type new_capacity = GrownCapacity(size_ + count);
+    pointer new_data = alloc_traits::allocate(alloc_, new_capacity);
+    size_type constructed = 0;
+    try {
+      for (; constructed < count; ++constructed) {
+        fill(new_data + pos + constructed, constructed, true);
+      }
+      TransferElements(pos, data_, new_data);
+      try {
+        TransferElements(size_ - pos, data_ + pos, new_data + pos + count);
+      } catch (...) {
+        DestroyElements(new_data, pos);
+        throw;
+      }
+    } catch (...) {
+      DestroyElements(new_data + pos, constructed);
+      alloc_traits::deallocate(alloc_, new_data, new_capacity);
+      throw;
+    }
+    DestroyTransferred(data_, size_);
+    freeDataArray(data_, capacity_, 0);
     data_ = new_data;
-    ++size_;
-    return data_ + before_insert_count;
+    capacity_ = new_capacity;
+    size_ += count;
   }
 };
 
@@ -0,0 +1,99 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+class AlignedTest : public ::testing::Test {
+ protected:
+  static bool IsAligned(const void *pointer, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+  }
+};
+
+TEST_F(AlignedTest, AlignedVector) {
+  dizing::aligned_vector<float, 32> floats;
+  for (int i = 0; i < 100; ++i) {
+    floats.push_back(static_cast<float>(i));
+    EXPECT_TRUE(IsAligned(floats.data(), 32));
+  }
+  floats.shrink_to_fit();
+  EXPECT_TRUE(IsAligned(floats.data(), 32));
+  EXPECT_EQ(floats[99], 99.0f);
+
+  dizing::vector<char, dizing::aligned_allocator<char, 64>> bytes(3, 'x');
+  EXPECT_TRUE(IsAligned(bytes.data(), 64));
+  auto copy = bytes;
+  EXPECT_TRUE(IsAligned(copy.data(), 64));
+  EXPECT_EQ(copy.get_allocator(), bytes.get_allocator());
+
+  // Rebound for the nodes of node based containers
+  dizing::list<double, dizing::aligned_allocator<double, 64>> nodes = {1, 2};
+  EXPECT_EQ(nodes.back(), 2);
+}
+
+TEST_F(AlignedTest, AlignedArray) {
+  dizing::aligned_array<float, 5, 32> values = {1, 2, 3, 4, 5};
+  EXPECT_EQ(alignof(decltype(values)), 32);
+  EXPECT_TRUE(IsAligned(values.data(), 32));
+  EXPECT_EQ(values.size(), 5);
+  EXPECT_EQ(values[4], 5);
+  EXPECT_EQ(dizing::simd::sum(values), 15);
+  auto [first, second, third, fourth, fifth] = values;
+  EXPECT_EQ(first + fifth, 6);
+  EXPECT_EQ(second + third + fourth, 9);
+
+  dizing::aligned_array<std::int8_t, 100, 64> many[2] = {};
+  EXPECT_TRUE(IsAligned(many[1].data(), 64));
+  EXPECT_TRUE(many[0] == many[1]);
+}
+
+TEST_F(AlignedTest, Padded) {
+  EXPECT_EQ(sizeof(dizing::padded<char>), dizing::cache_line_size);
+  EXPECT_EQ(alignof(dizing::padded<int>), dizing::cache_line_size);
+  EXPECT_EQ((sizeof(dizing::padded<char[100]>)), 2 * dizing::cache_line_size);
+  EXPECT_EQ((sizeof(dizing::padded<int, 16>)), 16);
+
+  dizing::array<dizing::padded<int>, 4> counters = {};
+  EXPECT_EQ(reinterpret_cast<char *>(&*counters[1]) -
+                reinterpret_cast<char *>(&*counters[0]),
+            64);
+  *counters[2] = 5;
+  EXPECT_EQ(counters[2].value, 5);
+  dizing::padded<std::vector<int>> numbers = {{1, 2, 3}};
+  EXPECT_EQ(numbers->size(), 3);
+}
+
+TEST_F(AlignedTest, PerCoreArray) {
+  constexpr int kThreads = 8;
+  constexpr int kIncrements = 10000;
+  dizing::per_core_array<std::atomic<long>> counters(4);
+  EXPECT_EQ(counters.size(), 4);
+  for (const auto &counter : counters) {
+    EXPECT_TRUE(IsAligned(&counter, dizing::cache_line_size));
+    EXPECT_EQ(counter->load(), 0);
+  }
+  // Eight threads share four elements
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&counters] {
+      std::atomic<long> &local = counters.local();
+      for (int i = 0; i < kIncrements; ++i) {
+        local.fetch_add(1, std::memory_order_relaxed);
+      }
+      EXPECT_EQ(&counters.local(), &local);
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  long total = 0;
+  for (const auto &counter : counters) {
+    total += counter->load();
+  }
+  EXPECT_EQ(total, kThreads * kIncrements);
+  EXPECT_THROW(dizing::per_core_array<int>(0), std::length_error);
+  EXPECT_GE(dizing::per_core_array<int>().size(), 1);
+}
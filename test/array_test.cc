@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "containers.h"
 #include "gtest/gtest.h"
 
@@ -80,4 +86,139 @@ TEST_F(ArrayTest, modifiers) {
     EXPECT_EQ(arr2_analog[i], "232");
     EXPECT_EQ(arr2[i], "new");
   }
-}
\ No newline at end of file
+}
+TEST_F(ArrayTest, comparisons) {
+  dizing::array<double, 6> copy = arr;
+  EXPECT_TRUE(copy == arr);
+  EXPECT_FALSE(copy != arr);
+  copy[5] = 1;
+  EXPECT_TRUE(arr < copy);
+  EXPECT_TRUE(copy > arr);
+  EXPECT_TRUE(arr <= copy);
+  EXPECT_FALSE(arr >= copy);
+  EXPECT_EQ(arr2 < arr2, std_arr2 < std_arr2);
+  dizing::array<int, 0> other_zero_arr = {};
+  EXPECT_TRUE(zero_arr == other_zero_arr);
+  EXPECT_FALSE(zero_arr < other_zero_arr);
+}
+
+TEST_F(ArrayTest, tuple_protocol) {
+  auto &[first, second, third, fourth, fifth, sixth] = arr;
+  first = 10;
+  EXPECT_EQ(arr[0], 10);
+  EXPECT_EQ(fourth, 4);
+  EXPECT_EQ(sixth, 0);
+  EXPECT_EQ(dizing::get<1>(const_arr), 2);
+  std::string moved = dizing::get<0>(std::move(arr2));
+  EXPECT_EQ(moved, "232");
+  EXPECT_EQ(std::tuple_size_v<decltype(arr)>, 6);
+  EXPECT_TRUE((std::is_same_v<std::tuple_element_t<0, decltype(arr2)>,
+                              std::string>));
+
+  auto strings = dizing::to_array({std::string("a"), std::string("b")});
+  EXPECT_EQ(strings.size(), 2);
+  EXPECT_EQ(strings[1], "b");
+  swap(strings, strings);
+  EXPECT_EQ(strings.front(), "a");
+}
+
+// Tables built at compile time
+
+namespace {
+
+constexpr dizing::array<std::uint32_t, 256> MakeCrc32Table() {
+  dizing::array<std::uint32_t, 256> table = {};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+constexpr auto kCrc32Table = MakeCrc32Table();
+
+template <std::size_t N>
+constexpr std::uint32_t Crc32(const char (&text)[N]) {
+  std::uint32_t crc = 0xFFFFFFFFu;
+  for (std::size_t i = 0; i + 1 < N; ++i) {
+    crc = kCrc32Table[(crc ^ static_cast<unsigned char>(text[i])) & 0xFF] ^
+          (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+static_assert(kCrc32Table[0] == 0);
+static_assert(kCrc32Table[1] == 0x77073096u);
+static_assert(kCrc32Table[255] == 0x2D02EF8Du);
+static_assert(Crc32("123456789") == 0xCBF43926u);
+
+constexpr auto kIdentifierChars = [] {
+  dizing::array<bool, 256> table = {};
+  for (int c = 0; c < 256; ++c) {
+    table[static_cast<std::size_t>(c)] = (c >= 'a' && c <= 'z') ||
+                                         (c >= 'A' && c <= 'Z') ||
+                                         (c >= '0' && c <= '9') || c == '_';
+  }
+  return table;
+}();
+static_assert(kIdentifierChars['_'] && kIdentifierChars['Q']);
+static_assert(!kIdentifierChars['-'] && !kIdentifierChars[0]);
+
+constexpr auto kKeywords = [] {
+  auto keywords = dizing::to_array<const char *>({"while", "if", "for"});
+  auto lengths = dizing::array<int, 3>{};
+  for (std::size_t i = 0; i < keywords.size(); ++i) {
+    while (keywords[i][lengths[i]] != '\0') {
+      ++lengths[i];
+    }
+  }
+  return lengths;
+}();
+static_assert(kKeywords == dizing::array<int, 3>{5, 2, 3});
+
+constexpr auto kSorted = [] {
+  auto values = dizing::to_array({42, 7, 19, 3, 7, 100, -5, 0});
+  dizing::constexpr_sort(values.begin(), values.end());
+  return values;
+}();
+static_assert(kSorted == dizing::to_array({-5, 0, 3, 7, 7, 19, 42, 100}));
+static_assert(dizing::constexpr_binary_search(kSorted.begin(), kSorted.end(),
+                                              19));
+static_assert(!dizing::constexpr_binary_search(kSorted.begin(),
+                                               kSorted.end(), 8));
+static_assert(*dizing::constexpr_lower_bound(kSorted.begin(), kSorted.end(),
+                                             7) == 7);
+
+constexpr auto kDescending = [] {
+  auto values = dizing::to_array({1, 2, 3, 4});
+  auto other = dizing::to_array({9, 9, 9, 9});
+  dizing::constexpr_sort(values.begin(), values.end(), std::greater<>());
+  values.swap(other);
+  other.fill(other[0]);
+  return other;
+}();
+static_assert(kDescending == dizing::array<int, 4>{4, 4, 4, 4});
+
+constexpr auto kPair = [] {
+  dizing::array<int, 2> values = {3, 4};
+  auto [first, second] = values;
+  return first * 10 + second;
+}();
+static_assert(kPair == 34);
+static_assert(dizing::array<int, 2>{1, 2} < dizing::array<int, 2>{1, 3});
+
+}  // namespace
+
+TEST_F(ArrayTest, constexpr_tables) {
+  EXPECT_EQ(kCrc32Table[8], 0x0EDB8832u);
+  std::array<int, 1000> values = {};
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int>((i * 7919) % 1009);
+  }
+  std::array<int, 1000> expected = values;
+  std::sort(expected.begin(), expected.end());
+  dizing::constexpr_sort(values.begin(), values.end());
+  EXPECT_EQ(values, expected);
+}
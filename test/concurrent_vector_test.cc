@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+namespace {
+// Allocator which throws bad_alloc while *fail is set.
+template <typename T>
+struct FailingAllocator {
+  using value_type = T;
+
+  explicit FailingAllocator(const bool *fail) : fail(fail) {}
+  template <typename U>
+  FailingAllocator(const FailingAllocator<U> &other) : fail(other.fail) {}
+
+  T *allocate(std::size_t n) {
+    if (*fail) {
+      throw std::bad_alloc();
+    }
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *pointer, std::size_t n) {
+    std::allocator<T>().deallocate(pointer, n);
+  }
+
+  template <typename U>
+  bool operator==(const FailingAllocator<U> &other) const {
+    return fail == other.fail;
+  }
+  template <typename U>
+  bool operator!=(const FailingAllocator<U> &other) const {
+    return fail != other.fail;
+  }
+
+  const bool *fail;
+};
+}  // namespace
+
+// Run under ThreadSanitizer with make tsan.
+class ConcurrentVectorTest : public ::testing::Test {
+ protected:
+  static constexpr int kThreads = 4;
+  static constexpr int kItemsPerThread = 20000;
+};
+
+TEST_F(ConcurrentVectorTest, SingleThread) {
+  dizing::concurrent_vector<std::string> strings;
+  EXPECT_TRUE(strings.empty());
+  EXPECT_EQ(strings.begin(), strings.end());
+  std::string &first = strings.push_back("first");
+  const std::string *address = &first;
+  // Enough elements for several segments, nothing is relocated
+  for (std::size_t i = 1; i < 1000; ++i) {
+    EXPECT_EQ(strings.emplace_back(std::to_string(i)), std::to_string(i));
+  }
+  EXPECT_EQ(&strings[0], address);
+  EXPECT_EQ(strings.size(), 1000);
+  EXPECT_EQ(strings.at(999), "999");
+  EXPECT_THROW(strings.at(1000), std::out_of_range);
+
+  std::size_t index = 0;
+  for (const std::string &value : strings) {
+    EXPECT_EQ(value, index == 0 ? "first" : std::to_string(index));
+    ++index;
+  }
+  EXPECT_EQ(index, 1000);
+  dizing::concurrent_vector<std::string>::const_iterator it = strings.begin();
+  EXPECT_EQ(strings.cend() - it, 1000);
+  EXPECT_EQ(it[500], "500");
+
+  // Elements are destroyed with the vector
+  auto shared = std::make_shared<int>(1);
+  {
+    dizing::concurrent_vector<std::shared_ptr<int>> owners;
+    owners.reserve(100);
+    owners.push_back(shared);
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST_F(ConcurrentVectorTest, ConcurrentAppend) {
+  dizing::concurrent_vector<int> values;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&values, t] {
+      for (int i = 0; i < kItemsPerThread; ++i) {
+        int value = t * kItemsPerThread + i;
+        int &appended = values.push_back(value);
+        EXPECT_EQ(appended, value);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  // Every value appended exactly once, in order per thread
+  ASSERT_EQ(values.size(), kThreads * kItemsPerThread);
+  std::vector<int> last(kThreads, -1);
+  std::vector<int> sorted(values.begin(), values.end());
+  for (int value : sorted) {
+    int thread = value / kItemsPerThread;
+    EXPECT_LT(last[static_cast<std::size_t>(thread)], value);
+    last[static_cast<std::size_t>(thread)] = value;
+  }
+  std::sort(sorted.begin(), sorted.end());
+  for (std::size_t i = 0; i < sorted.size(); ++i) {
+    EXPECT_EQ(sorted[i], static_cast<int>(i));
+  }
+}
+
+TEST_F(ConcurrentVectorTest, ReadWhileAppending) {
+  dizing::concurrent_vector<std::string> values;
+  std::atomic<int> writers(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < kItemsPerThread / 4; ++i) {
+        values.emplace_back(std::size_t{64}, 'v');
+      }
+      writers.fetch_sub(1, std::memory_order_release);
+    });
+  }
+  // The committed prefix only grows and holds constructed elements
+  std::size_t seen = 0;
+  bool done = false;
+  while (!done) {
+    done = writers.load(std::memory_order_acquire) == 0;
+    std::size_t count = 0;
+    for (const std::string &value : values) {
+      EXPECT_EQ(value.size(), 64);
+      ++count;
+    }
+    EXPECT_GE(count, seen);
+    seen = count;
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(seen, kThreads * (kItemsPerThread / 4));
+}
+
+TEST_F(ConcurrentVectorTest, FailedSegmentAllocation) {
+  bool fail = false;
+  dizing::concurrent_vector<int, FailingAllocator<int>> values{
+      FailingAllocator<int>(&fail)};
+  // Fills the first segment
+  for (int i = 0; i < 16; ++i) {
+    values.push_back(i);
+  }
+  fail = true;
+  EXPECT_THROW(values.push_back(16), std::bad_alloc);
+  EXPECT_EQ(values.size(), 16);
+  fail = false;
+  // The failed append left no hole
+  values.push_back(16);
+  values.push_back(17);
+  EXPECT_EQ(values.size(), 18);
+  EXPECT_EQ(values.at(17), 17);
+  EXPECT_EQ(values.end() - values.begin(), 18);
+}
@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+#include "test_class.h"
+
+class DequeTest : public ::testing::Test {
+ protected:
+  using counting = dizing::counting_allocator<int>;
+
+  // More than one block of ints
+  static constexpr int kElements = 3000;
+
+  dizing::operation_counts counts = dizing::operation_counts();
+
+  template <typename Deque, typename T>
+  static void check_with_std(const Deque& deque, const std::deque<T>& std_dq) {
+    EXPECT_EQ(deque.size(), std_dq.size());
+    auto it = deque.begin();
+    for (size_t i = 0; i < std_dq.size(); ++i) {
+      EXPECT_EQ(*it, std_dq[i]);
+      EXPECT_EQ(deque[i], std_dq[i]);
+      ++it;
+    }
+    EXPECT_EQ(it, deque.end());
+  }
+};
+
+TEST_F(DequeTest, Constructors) {
+  dizing::deque<testClass> dq = {{"a", "b"}, {"c", "d"}};
+  std::deque<testClass> std_dq = {{"a", "b"}, {"c", "d"}};
+  check_with_std(dq, std_dq);
+
+  dizing::deque<testClass> copy(dq);
+  check_with_std(copy, std_dq);
+  dizing::deque<testClass> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  check_with_std(moved, std_dq);
+
+  dizing::deque<int> sized(5, 7);
+  check_with_std(sized, std::deque<int>(5, 7));
+  std::vector<int> source = {1, 2, 3};
+  dizing::deque<int> from_range(source.begin(), source.end());
+  check_with_std(from_range, std::deque<int>{1, 2, 3});
+
+  dizing::deque<testClass> assigned;
+  assigned = dq;
+  check_with_std(assigned, std_dq);
+  assigned = std::move(dq);
+  check_with_std(assigned, std_dq);
+  assigned.assign({{"e", "f"}});
+  check_with_std(assigned, std::deque<testClass>{{"e", "f"}});
+}
+
+TEST_F(DequeTest, BothEnds) {
+  dizing::deque<int> dq;
+  std::deque<int> std_dq;
+  for (int i = 0; i < kElements; ++i) {
+    if (i % 3 == 0) {
+      dq.push_front(i);
+      std_dq.push_front(i);
+    } else {
+      dq.push_back(i);
+      std_dq.push_back(i);
+    }
+  }
+  check_with_std(dq, std_dq);
+  EXPECT_EQ(dq.front(), std_dq.front());
+  EXPECT_EQ(dq.back(), std_dq.back());
+  EXPECT_THROW(dq.at(dq.size()), std::out_of_range);
+
+  for (int i = 0; i < kElements / 2; ++i) {
+    if (i % 2 == 0) {
+      dq.pop_front();
+      std_dq.pop_front();
+    } else {
+      dq.pop_back();
+      std_dq.pop_back();
+    }
+  }
+  check_with_std(dq, std_dq);
+  while (!dq.empty()) {
+    dq.pop_back();
+  }
+  dq.emplace_front(1);
+  dq.emplace_back(2);
+  check_with_std(dq, std::deque<int>{1, 2});
+}
+
+TEST_F(DequeTest, RandomAccessIterators) {
+  dizing::deque<int> dq;
+  std::deque<int> std_dq;
+  for (int i = 0; i < kElements; ++i) {
+    dq.push_front((i * 7919) % kElements);
+    std_dq.push_front((i * 7919) % kElements);
+  }
+  std::sort(dq.begin(), dq.end());
+  std::sort(std_dq.begin(), std_dq.end());
+  check_with_std(dq, std_dq);
+
+  auto it = dq.begin() + 1000;
+  EXPECT_EQ(it - dq.begin(), 1000);
+  EXPECT_EQ(it[5], dq[1005]);
+  EXPECT_TRUE(dq.begin() < it);
+  dizing::deque<int>::const_iterator const_it = it;
+  EXPECT_EQ(*(const_it - 1), dq[999]);
+  EXPECT_TRUE(std::binary_search(dq.cbegin(), dq.cend(), 42));
+}
+
+TEST_F(DequeTest, StableReferences) {
+  dizing::deque<testClass> dq = {{"a", "b"}};
+  const testClass* first = &dq.front();
+  std::vector<const testClass*> pointers;
+  for (int i = 0; i < kElements; ++i) {
+    pointers.push_back(&dq.emplace_back("back", std::to_string(i)));
+    dq.emplace_front("front", std::to_string(i));
+  }
+  EXPECT_EQ(first, &dq[static_cast<std::size_t>(kElements)]);
+  for (std::size_t i = 0; i < pointers.size(); ++i) {
+    EXPECT_EQ(pointers[i], &dq[static_cast<std::size_t>(kElements) + 1 + i]);
+  }
+}
+
+TEST_F(DequeTest, InsertErase) {
+  dizing::deque<int> dq;
+  std::deque<int> std_dq;
+  for (int i = 0; i < kElements; ++i) {
+    dq.push_back(i);
+    std_dq.push_back(i);
+  }
+  for (std::ptrdiff_t pos : {0, 10, 1500, 2990}) {
+    EXPECT_EQ(*dq.insert(dq.begin() + pos, -1), -1);
+    std_dq.insert(std_dq.begin() + pos, -1);
+  }
+  check_with_std(dq, std_dq);
+  EXPECT_EQ(*dq.erase(dq.begin() + 10), *std_dq.erase(std_dq.begin() + 10));
+  dq.erase(dq.begin() + 5, dq.begin() + 1200);
+  std_dq.erase(std_dq.begin() + 5, std_dq.begin() + 1200);
+  dq.erase(dq.end() - 700, dq.end() - 3);
+  std_dq.erase(std_dq.end() - 700, std_dq.end() - 3);
+  check_with_std(dq, std_dq);
+
+  dq.resize(10);
+  std_dq.resize(10);
+  dq.resize(20, 5);
+  std_dq.resize(20, 5);
+  check_with_std(dq, std_dq);
+  dq.clear();
+  EXPECT_TRUE(dq.empty());
+}
+
+TEST_F(DequeTest, ExceptionSafety) {
+  struct Throwing {
+    explicit Throwing(int value) : value_(value) {
+      if (value < 0) {
+        throw std::invalid_argument("negative");
+      }
+    }
+    int value_;
+  };
+  dizing::deque<Throwing, dizing::counting_allocator<Throwing>> dq{
+      dizing::counting_allocator<Throwing>(counts)};
+  EXPECT_THROW(dq.emplace_back(-1), std::invalid_argument);
+  EXPECT_THROW(dq.emplace_front(-1), std::invalid_argument);
+  EXPECT_TRUE(dq.empty());
+  dq.emplace_back(1);
+  EXPECT_THROW(dq.emplace_front(-1), std::invalid_argument);
+  EXPECT_EQ(dq.size(), 1);
+  EXPECT_EQ(dq.front().value_, 1);
+  dq.clear();
+  dq.shrink_to_fit();
+  EXPECT_EQ(counts.live_bytes, 0);
+}
+
+TEST_F(DequeTest, BoundedMemory) {
+  dizing::deque<int, counting> dq{counting(counts)};
+  auto slide = [&] {
+    for (int i = 0; i < 100 * kElements; ++i) {
+      dq.pop_front();
+      dq.push_back(i);
+    }
+  };
+  for (int i = 0; i < kElements; ++i) {
+    dq.push_back(i);
+  }
+  slide();
+  // Once warmed up, a sliding window reuses blocks and the map is
+  // recentered instead of growing
+  std::size_t warmed_up = counts.allocations;
+  slide();
+  EXPECT_EQ(counts.allocations, warmed_up);
+  EXPECT_EQ(dq.front(), 99 * kElements);
+
+  dizing::deque<int, counting> moved(std::move(dq));
+  EXPECT_EQ(moved.get_allocator().counts().allocations, warmed_up);
+  moved.swap(dq);
+  EXPECT_EQ(dq.size(), static_cast<std::size_t>(kElements));
+  {
+    dizing::deque<int, counting> destroyed(std::move(dq));
+  }
+  EXPECT_EQ(counts.live_bytes, 0);
+}
+
+TEST_F(DequeTest, Propagation) {
+  dizing::pmr::arena_resource first_arena;
+  dizing::pmr::arena_resource second_arena;
+  dizing::pmr::deque<std::string> first({"a", "b", "c"}, &first_arena);
+  dizing::pmr::deque<std::string> second({"d"}, &second_arena);
+
+  dizing::pmr::deque<std::string> copy = first;
+  EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+  second = first;
+  EXPECT_EQ(second.get_allocator().resource(), &second_arena);
+  check_with_std(second, std::deque<std::string>{"a", "b", "c"});
+
+  second = std::move(copy);
+  EXPECT_EQ(second.get_allocator().resource(), &second_arena);
+  EXPECT_TRUE(copy.empty());
+  check_with_std(second, std::deque<std::string>{"a", "b", "c"});
+
+  dizing::pmr::deque<std::string> moved(std::move(first), &second_arena);
+  EXPECT_TRUE(first.empty());
+  check_with_std(moved, std::deque<std::string>{"a", "b", "c"});
+
+  dizing::pmr::deque<dizing::pmr::vector<int>> nested(&first_arena);
+  nested.emplace_front(3, 1);
+  EXPECT_EQ(nested.front().get_allocator().resource(), &first_arena);
+}
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+class HiveTest : public ::testing::Test {
+ protected:
+  using counting = dizing::counting_allocator<int>;
+
+  dizing::operation_counts counts = dizing::operation_counts();
+
+  // Elements are compared as sorted sequences, in both directions of
+  // iteration.
+  template <typename Hive, typename T>
+  static void check_with_std(const Hive &hive, std::vector<T> std_values) {
+    EXPECT_EQ(hive.size(), std_values.size());
+    std::vector<T> values(hive.begin(), hive.end());
+    std::vector<T> reversed;
+    for (auto it = hive.end(); it != hive.begin();) {
+      reversed.push_back(*--it);
+    }
+    std::reverse(reversed.begin(), reversed.end());
+    EXPECT_EQ(reversed, values);
+    std::sort(values.begin(), values.end());
+    std::sort(std_values.begin(), std_values.end());
+    EXPECT_EQ(values, std_values);
+  }
+};
+
+TEST_F(HiveTest, InsertErase) {
+  dizing::hive<std::string> hive;
+  EXPECT_TRUE(hive.empty());
+  EXPECT_EQ(hive.begin(), hive.end());
+  std::vector<std::string> std_values;
+  for (int i = 0; i < 100; ++i) {
+    hive.insert(std::to_string(i));
+    std_values.push_back(std::to_string(i));
+  }
+  check_with_std(hive, std_values);
+
+  // Erase every other element, erase returns the next one
+  for (auto it = hive.begin(); it != hive.end();) {
+    it = hive.erase(it);
+    if (it != hive.end()) {
+      ++it;
+    }
+  }
+  std_values.clear();
+  for (int i = 1; i < 100; i += 2) {
+    std_values.push_back(std::to_string(i));
+  }
+  check_with_std(hive, std_values);
+
+  // Erased slots are reused before blocks are added
+  std::size_t capacity = hive.capacity();
+  for (int i = 0; i < 50; ++i) {
+    hive.emplace(2, 'x');
+    std_values.emplace_back(2, 'x');
+  }
+  EXPECT_EQ(hive.capacity(), capacity);
+  check_with_std(hive, std_values);
+
+  // Blocks are freed with their last element
+  for (auto it = hive.begin(); it != hive.end();) {
+    it = hive.erase(it);
+  }
+  EXPECT_TRUE(hive.empty());
+  EXPECT_EQ(hive.capacity(), 0);
+  EXPECT_EQ(hive.begin(), hive.end());
+}
+
+TEST_F(HiveTest, StablePointers) {
+  dizing::hive<int> hive;
+  std::unordered_map<int, int *> pointers;
+  std::mt19937 random(11);
+  int next = 0;
+  for (int i = 0; i < 50000; ++i) {
+    if (pointers.empty() || random() % 5 < 3) {
+      pointers[next] = &*hive.insert(next);
+      ++next;
+    } else {
+      auto it = pointers.begin();
+      std::advance(it, random() % pointers.size());
+      // Erase by iteration to the element, which checks the skipfield
+      auto pos = std::find(hive.begin(), hive.end(), it->first);
+      ASSERT_EQ(&*pos, it->second);
+      hive.erase(pos);
+      pointers.erase(it);
+    }
+    if (i % 1000 == 0) {
+      for (const auto &[value, pointer] : pointers) {
+        ASSERT_EQ(*pointer, value);
+      }
+    }
+  }
+  std::vector<int> std_values;
+  for (const auto &[value, pointer] : pointers) {
+    EXPECT_EQ(*pointer, value);
+    std_values.push_back(value);
+  }
+  check_with_std(hive, std_values);
+}
+
+TEST_F(HiveTest, ExceptionSafety) {
+  struct Throwing {
+    explicit Throwing(int value) : value_(value) {
+      if (value < 0) {
+        throw std::invalid_argument("negative");
+      }
+    }
+    int value_;
+  };
+  {
+    dizing::hive<Throwing, dizing::counting_allocator<Throwing>> hive{
+        dizing::counting_allocator<Throwing>(counts)};
+    EXPECT_THROW(hive.emplace(-1), std::invalid_argument);
+    EXPECT_TRUE(hive.empty());
+    EXPECT_EQ(counts.live_bytes, 0);
+    auto first = hive.emplace(1);
+    hive.emplace(2);
+    EXPECT_THROW(hive.emplace(-1), std::invalid_argument);
+    hive.erase(first);
+    EXPECT_THROW(hive.emplace(-1), std::invalid_argument);
+    EXPECT_EQ(hive.size(), 1);
+    EXPECT_EQ(hive.begin()->value_, 2);
+    hive.emplace(3);
+    EXPECT_EQ(hive.begin()->value_, 3);
+  }
+  EXPECT_EQ(counts.live_bytes, 0);
+}
+
+TEST_F(HiveTest, Propagation) {
+  {
+    dizing::hive<int, counting> hive({1, 2, 3}, counting(counts));
+    dizing::hive<int, counting> copy = hive;
+    check_with_std(copy, std::vector<int>{1, 2, 3});
+    dizing::hive<int, counting> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    check_with_std(moved, std::vector<int>{1, 2, 3});
+    moved.swap(copy);
+    check_with_std(copy, std::vector<int>{1, 2, 3});
+    hive = copy;
+    copy = std::move(hive);
+    check_with_std(copy, std::vector<int>{1, 2, 3});
+  }
+  EXPECT_EQ(counts.live_bytes, 0);
+
+  dizing::pmr::arena_resource first_arena;
+  dizing::pmr::arena_resource second_arena;
+  dizing::pmr::hive<std::string> first({"a", "b", "c"}, &first_arena);
+  dizing::pmr::hive<std::string> second({"d"}, &second_arena);
+  second = first;
+  EXPECT_EQ(second.get_allocator().resource(), &second_arena);
+  check_with_std(second, std::vector<std::string>{"a", "b", "c"});
+  dizing::pmr::hive<std::string> moved(std::move(first), &second_arena);
+  EXPECT_TRUE(first.empty());
+  check_with_std(moved, std::vector<std::string>{"a", "b", "c"});
+
+  dizing::pmr::hive<dizing::pmr::vector<int>> nested(&first_arena);
+  auto it = nested.emplace(3, 1);
+  EXPECT_EQ(it->get_allocator().resource(), &first_arena);
+}
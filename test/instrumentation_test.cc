@@ -0,0 +1,131 @@
+#include <string>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+#include "operation_bounds.h"
+
+class InstrumentationTest : public ::testing::Test {
+ protected:
+  using element = dizing::instrumented<std::string>;
+  using allocator = dizing::counting_allocator<element>;
+  using vector = dizing::vector<element, allocator>;
+  using list = dizing::list<element, allocator>;
+
+  static constexpr std::size_t kElements = 1000;
+
+  dizing::operation_counts counts = dizing::operation_counts();
+
+  static element MakeElement(std::size_t i) {
+    return element("element number " + std::to_string(i));
+  }
+};
+
+TEST_F(InstrumentationTest, CountingScope) {
+  dizing::operation_counts outer;
+  element value("a");
+  {
+    dizing::counting_scope scope(outer);
+    element copy = value;
+    {
+      dizing::counting_scope inner(counts);
+      element moved = std::move(copy);
+      moved = value;
+    }
+    copy = element("b");
+  }
+  EXPECT_EQ(outer.copies, 1);
+  EXPECT_EQ(outer.constructions, 1);
+  EXPECT_EQ(outer.moves, 1);
+  EXPECT_EQ(outer.destructions, 2);
+  EXPECT_EQ(counts.moves, 1);
+  EXPECT_EQ(counts.copies, 1);
+  EXPECT_EQ(counts.destructions, 1);
+  element untracked = value;
+  EXPECT_EQ(outer.copies, 1);
+}
+
+TEST_F(InstrumentationTest, CountingAllocator) {
+  vector vec{allocator(counts)};
+  dizing::count_operations(counts, [&] {
+    for (std::size_t i = 0; i < 5; ++i) {
+      vec.emplace_back("value");
+    }
+  });
+  EXPECT_EQ(counts.allocations, 4);
+  EXPECT_EQ(counts.deallocations, 3);
+  EXPECT_EQ(counts.live_bytes, 8 * sizeof(element));
+  EXPECT_EQ(counts.allocated_bytes, 15 * sizeof(element));
+  EXPECT_EQ(counts.peak_bytes, 12 * sizeof(element));
+  EXPECT_EQ(counts.constructions, 5);
+  EXPECT_EQ(counts.moves, 7);
+
+  // Rebound and copied allocators share counts
+  list ll{allocator(counts)};
+  vector copy = vec;
+  dizing::count_operations(counts, [&] { ll.emplace_back("node"); });
+  EXPECT_EQ(counts.allocations, 1);
+  EXPECT_EQ(&copy.get_allocator().counts(), &counts);
+  EXPECT_TRUE(ll.get_allocator() == vec.get_allocator());
+}
+
+TEST_F(InstrumentationTest, VectorBounds) {
+  vector vec{allocator(counts)};
+  const auto value = MakeElement(0);
+
+  // Amortized push_back: at most one relocation move per element
+  dizing::count_operations(counts, [&] {
+    for (std::size_t i = 0; i < kElements; ++i) {
+      vec.push_back(value);
+    }
+  });
+  EXPECT_EQ(counts.copies, kElements);
+  ExpectAmortizedAtMost(counts.moves, 1.1, kElements);
+  ExpectAmortizedAtMost(counts.allocations, 0.02, kElements);
+
+  // Erase and insert within capacity only shift elements
+  OperationBounds in_place = OperationBounds::NoAllocationsNoCopies();
+  in_place.moves = kElements;
+  auto erase = [&] { vec.erase(vec.begin() + 10, vec.begin() + 20); };
+  ExpectWithinBounds(dizing::count_operations(counts, erase), in_place);
+  in_place.constructions = 1;
+  auto insert = [&] { vec.insert(vec.begin() + 10, MakeElement(1)); };
+  ExpectWithinBounds(dizing::count_operations(counts, insert), in_place);
+
+  // Move of the whole vector touches no element
+  OperationBounds untouched = OperationBounds::NoAllocationsNoCopies();
+  untouched.moves = 0;
+  untouched.destructions = 0;
+  auto move = [&] {
+    vector moved(std::move(vec));
+    vec = std::move(moved);
+  };
+  ExpectWithinBounds(dizing::count_operations(counts, move), untouched);
+  EXPECT_EQ(vec.size(), kElements - 9);
+}
+
+TEST_F(InstrumentationTest, ListBounds) {
+  list ll{allocator(counts)};
+  dizing::count_operations(counts, [&] {
+    for (std::size_t i = 0; i < kElements; ++i) {
+      ll.emplace_back(std::to_string(kElements - i));
+    }
+  });
+  EXPECT_EQ(counts.allocations, kElements);
+  EXPECT_EQ(counts.constructions, kElements);
+  EXPECT_EQ(counts.moves, 0);
+
+  // Node relinking operations don't touch elements
+  OperationBounds relinking = OperationBounds::NoAllocationsNoCopies();
+  relinking.moves = 0;
+  relinking.destructions = 0;
+  auto relink = [&] {
+    ll.sort();
+    ll.reverse();
+    list other{allocator(counts)};
+    other.splice(other.end(), ll);
+    ll.merge(other);
+  };
+  ExpectWithinBounds(dizing::count_operations(counts, relink), relinking);
+  EXPECT_EQ(ll.size(), kElements);
+}
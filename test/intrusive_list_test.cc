@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+namespace {
+// Object linked into two lists at once.
+struct Connection {
+  explicit Connection(int id) : id(id) {}
+
+  int id;
+  dizing::list_hook active = dizing::list_hook();
+  dizing::list_hook timers = dizing::list_hook();
+};
+
+// Not standard layout: the hook follows a vtable pointer and a base.
+struct Task {
+  virtual ~Task() = default;
+  virtual int Priority() const { return 0; }
+};
+struct Timer : Task {
+  explicit Timer(int id) : id(id) {}
+  int Priority() const override { return id; }
+
+  int id;
+  dizing::list_hook hook = dizing::list_hook();
+};
+}  // namespace
+
+class IntrusiveListTest : public ::testing::Test {
+ protected:
+  using active_list = dizing::intrusive_list<Connection, &Connection::active>;
+  using timer_list = dizing::intrusive_list<Connection, &Connection::timers>;
+
+  std::vector<Connection> pool = MakePool(8);
+
+  static std::vector<Connection> MakePool(int count) {
+    std::vector<Connection> connections;
+    for (int i = 0; i < count; ++i) {
+      connections.emplace_back(i);
+    }
+    return connections;
+  }
+
+  template <typename List>
+  static void check_ids(const List& ll, const std::vector<int>& ids) {
+    EXPECT_EQ(ll.size(), ids.size());
+    auto it = ll.begin();
+    for (int id : ids) {
+      EXPECT_EQ(it->id, id);
+      ++it;
+    }
+    EXPECT_EQ(it, ll.end());
+  }
+};
+
+TEST_F(IntrusiveListTest, LinksOwnedObjects) {
+  active_list active;
+  timer_list timers;
+  EXPECT_TRUE(active.empty());
+  for (auto& connection : pool) {
+    active.push_back(connection);
+    timers.push_front(connection);
+  }
+  check_ids(active, {0, 1, 2, 3, 4, 5, 6, 7});
+  check_ids(timers, {7, 6, 5, 4, 3, 2, 1, 0});
+  EXPECT_EQ(&active.front(), &pool[0]);
+  EXPECT_EQ(&timers.back(), &pool[0]);
+
+  active.pop_front();
+  timers.pop_back();
+  EXPECT_FALSE(pool[0].active.is_linked());
+  active.front().id = 42;
+  EXPECT_EQ(pool[1].id, 42);
+  auto found = std::find_if(timers.begin(), timers.end(),
+                            [](const Connection& c) { return c.id == 5; });
+  EXPECT_EQ(&*found, &pool[5]);
+}
+
+TEST_F(IntrusiveListTest, UnlinkFromElement) {
+  active_list active;
+  for (auto& connection : pool) {
+    active.push_back(connection);
+  }
+  pool[3].active.unlink();
+  pool[7].active.unlink();
+  EXPECT_FALSE(pool[3].active.is_linked());
+  check_ids(active, {0, 1, 2, 4, 5, 6});
+
+  auto it = active.erase(active_list::iterator_to(pool[1]));
+  EXPECT_EQ(&*it, &pool[2]);
+  it = active.insert(it, pool[7]);
+  EXPECT_EQ(&*it, &pool[7]);
+  check_ids(active, {0, 7, 2, 4, 5, 6});
+  active.erase(std::next(active.begin()), std::prev(active.end()));
+  check_ids(active, {0, 6});
+
+  // Destroyed elements unlink themselves
+  {
+    Connection temporary(100);
+    active.push_back(temporary);
+    check_ids(active, {0, 6, 100});
+  }
+  check_ids(active, {0, 6});
+  active.clear();
+  EXPECT_FALSE(pool[0].active.is_linked());
+}
+
+TEST_F(IntrusiveListTest, Splice) {
+  active_list first;
+  active_list second;
+  for (std::size_t i = 0; i < 4; ++i) {
+    first.push_back(pool[i]);
+    second.push_back(pool[i + 4]);
+  }
+  first.splice(std::next(first.begin()), second,
+               active_list::iterator_to(pool[6]));
+  check_ids(first, {0, 6, 1, 2, 3});
+  first.splice(first.end(), second, second.begin(),
+               std::next(second.begin(), 2));
+  check_ids(first, {0, 6, 1, 2, 3, 4, 5});
+  first.splice(first.begin(), second);
+  check_ids(first, {7, 0, 6, 1, 2, 3, 4, 5});
+  EXPECT_TRUE(second.empty());
+
+  active_list moved(std::move(first));
+  EXPECT_TRUE(first.empty());
+  EXPECT_EQ(moved.size(), 8);
+  moved.swap(second);
+  EXPECT_TRUE(moved.empty());
+  check_ids(second, {7, 0, 6, 1, 2, 3, 4, 5});
+
+  // Copies of an object are not linked
+  Connection copy = pool[0];
+  EXPECT_FALSE(copy.active.is_linked());
+  EXPECT_TRUE(pool[0].active.is_linked());
+}
+
+TEST_F(IntrusiveListTest, PolymorphicOwner) {
+  std::vector<Timer> timers;
+  for (int i = 0; i < 4; ++i) {
+    timers.emplace_back(i);
+  }
+  dizing::intrusive_list<Timer, &Timer::hook> ll;
+  ll.push_back(timers[2]);
+  ll.push_front(timers[1]);
+  ll.push_back(timers[3]);
+  std::vector<const Timer*> linked;
+  for (const Timer& timer : ll) {
+    linked.push_back(&timer);
+    EXPECT_EQ(timer.Priority(), timer.id);
+  }
+  EXPECT_EQ(linked, (std::vector<const Timer*>{&timers[1], &timers[2],
+                                                &timers[3]}));
+  ll.clear();
+}
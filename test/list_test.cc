@@ -1,4 +1,7 @@
+#include <functional>
 #include <list>
+#include <stdexcept>
+#include <utility>
 
 #include "containers.h"
 #include "gtest/gtest.h"
@@ -206,4 +209,137 @@ TEST_F(ListTest, InsertMany) {
       {"-1", "0"}, {"uno", "map"},    {"Maron", "Kubanov"}, {"3", "4"},
       {"1", "2"},  {"all", "is end"}, {"zoo", "park"}};
   check_with_std(test_list, check_list);
-}
\ No newline at end of file
+}
+TEST_F(ListTest, MergeSort) {
+  // Stability: equal keys keep their order
+  using pair = std::pair<int, int>;
+  auto by_key = [](const pair& a, const pair& b) { return a.first < b.first; };
+  dizing::list<pair> pairs;
+  std::list<pair> std_pairs;
+  for (int i = 0; i < 1000; ++i) {
+    pairs.push_back({(i * 7919) % 13, i});
+    std_pairs.push_back({(i * 7919) % 13, i});
+  }
+  pairs.sort(by_key);
+  std_pairs.sort(by_key);
+  check_with_std(pairs, std_pairs);
+
+  // Random values, no element is copied or moved
+  dizing::list<testClass> objects;
+  std::list<testClass> std_objects;
+  unsigned seed = 12345;
+  for (int i = 0; i < 777; ++i) {
+    seed = seed * 1103515245 + 12345;
+    testClass value(std::to_string(seed % 1000), std::to_string(i));
+    objects.push_back(value);
+    std_objects.push_back(value);
+  }
+  auto by_a = [](const testClass& x, const testClass& y) { return x.a < y.a; };
+  testClass::ResetCounters();
+  objects.sort(by_a);
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 0);
+  std_objects.sort(by_a);
+  check_with_std(objects, std_objects);
+
+  // Descending order, tiny lists
+  dizing::list<int> ints = {5, 1, 4};
+  ints.sort(std::greater<int>());
+  check_with_std(ints, std::list<int>{5, 4, 1});
+  dizing::list<int> single = {1};
+  single.sort();
+  check_with_std(single, std::list<int>{1});
+  dizing::list<int> empty;
+  empty.sort();
+  EXPECT_TRUE(empty.empty());
+}
+
+TEST_F(ListTest, MergeSortException) {
+  dizing::list<int> ints;
+  for (int i = 0; i < 100; ++i) {
+    ints.push_back(100 - i);
+  }
+  int calls = 0;
+  auto throwing = [&calls](int a, int b) {
+    if (++calls == 150) {
+      throw std::runtime_error("comparison failed");
+    }
+    return a < b;
+  };
+  EXPECT_THROW(ints.sort(throwing), std::runtime_error);
+  EXPECT_EQ(ints.size(), 100);
+  ints.sort();
+  int expected = 1;
+  for (int value : ints) {
+    EXPECT_EQ(value, expected++);
+  }
+  EXPECT_EQ(expected, 101);
+}
+
+TEST_F(ListTest, MergeTail) {
+  dizing::list<int> first = {1, 5};
+  std::list<int> std_first = {1, 5};
+  dizing::list<int> second = {2, 7, 9};
+  std::list<int> std_second = {2, 7, 9};
+  first.merge(second);
+  std_first.merge(std_second);
+  check_with_std(first, std_first);
+  check_with_std(second, std_second);
+  dizing::list<int> empty;
+  first.merge(empty);
+  empty.merge(first);
+  check_with_std(empty, std::list<int>{1, 2, 5, 7, 9});
+  EXPECT_TRUE(first.empty());
+}
+
+TEST_F(ListTest, SpliceRanges) {
+  dizing::list<int> ll = {1, 2, 3, 4, 5};
+  std::list<int> stdll = {1, 2, 3, 4, 5};
+  dizing::list<int> other = {6, 7, 8, 9};
+  std::list<int> std_other = {6, 7, 8, 9};
+  dizing::list<int> empty;
+  std::list<int> std_empty;
+
+  // Empty sources
+  ll.splice(ll.begin(), empty);
+  ll.splice(ll.end(), empty, empty.begin(), empty.end());
+  ll.splice(ll.end(), other, other.begin(), other.begin());
+  check_with_std(ll, stdll);
+  check_with_std(other, std_other);
+  empty.splice(empty.end(), empty);
+  EXPECT_TRUE(empty.empty());
+
+  // Single elements at boundaries
+  ll.splice(ll.begin(), other, --other.end());
+  stdll.splice(stdll.begin(), std_other, --std_other.end());
+  ll.splice(ll.end(), other, other.begin());
+  stdll.splice(stdll.end(), std_other, std_other.begin());
+  empty.splice(empty.begin(), other, other.begin());
+  std_empty.splice(std_empty.begin(), std_other, std_other.begin());
+  check_with_std(ll, stdll);
+  check_with_std(other, std_other);
+  check_with_std(empty, std_empty);
+
+  // Ranges to and from other lists
+  ll.splice(++ll.begin(), other, other.begin(), other.end());
+  stdll.splice(++stdll.begin(), std_other, std_other.begin(), std_other.end());
+  other.splice(other.end(), ll, ll.begin(), ++++ll.begin());
+  std_other.splice(std_other.end(), stdll, stdll.begin(), ++++stdll.begin());
+  check_with_std(ll, stdll);
+  check_with_std(other, std_other);
+
+  // Self splice
+  ll.splice(ll.begin(), ll, --ll.end());
+  stdll.splice(stdll.begin(), stdll, --stdll.end());
+  ll.splice(ll.begin(), ll, ll.begin());
+  stdll.splice(stdll.begin(), stdll, stdll.begin());
+  ll.splice(ll.end(), ll, --ll.end());
+  stdll.splice(stdll.end(), stdll, --stdll.end());
+  ll.splice(ll.end(), ll, ll.begin(), ++++ll.begin());
+  stdll.splice(stdll.end(), stdll, stdll.begin(), ++++stdll.begin());
+  ll.splice(ll.begin(), ll, ++ll.begin(), ll.end());
+  stdll.splice(stdll.begin(), stdll, ++stdll.begin(), stdll.end());
+  ll.splice(ll.begin(), ll);
+  check_with_std(ll, stdll);
+  EXPECT_EQ(*--ll.end(), stdll.back());
+}
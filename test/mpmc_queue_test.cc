@@ -0,0 +1,125 @@
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+// Run under ThreadSanitizer with make tsan.
+class MpmcQueueTest : public ::testing::Test {
+ protected:
+  static constexpr int kThreads = 4;
+  static constexpr int kItemsPerProducer = 20000;
+
+  // Pushes values [first, first + count) one by one or in batches.
+  template <typename Queue>
+  static void Produce(Queue& queue, int first, int count, bool batch) {
+    std::vector<int> items;
+    for (int i = first; i < first + count; ++i) {
+      items.push_back(i);
+    }
+    auto it = items.begin();
+    while (it != items.end()) {
+      bool pushed = false;
+      if (batch) {
+        auto last = it + std::min<std::ptrdiff_t>(7, items.end() - it);
+        auto count_pushed = queue.try_push_batch(it, last);
+        it += static_cast<std::ptrdiff_t>(count_pushed);
+        pushed = count_pushed > 0;
+      } else if (queue.try_push(*it)) {
+        ++it;
+        pushed = true;
+      }
+      if (!pushed) {
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+
+TEST_F(MpmcQueueTest, SingleThread) {
+  dizing::mpmc_queue<std::string, 4> queue;
+  EXPECT_EQ(queue.capacity(), 4);
+  std::string value;
+  EXPECT_FALSE(queue.try_pop(value));
+  EXPECT_TRUE(queue.try_push("first"));
+  EXPECT_TRUE(queue.try_emplace(std::size_t{3}, 'x'));
+  EXPECT_EQ(queue.size_approx(), 2);
+  EXPECT_TRUE(queue.try_pop(value));
+  EXPECT_EQ(value, "first");
+
+  // Wraps around the ring, copying batches would throw after claiming
+  std::vector<std::string> batch = {"a", "b", "c", "d"};
+  EXPECT_EQ(queue.try_push_batch(std::make_move_iterator(batch.begin()),
+                                 std::make_move_iterator(batch.end())),
+            3);
+  EXPECT_FALSE(queue.try_push("full"));
+  std::vector<std::string> popped;
+  EXPECT_EQ(queue.try_pop_batch(std::back_inserter(popped), 10), 4);
+  EXPECT_EQ(popped, (std::vector<std::string>{"xxx", "a", "b", "c"}));
+  EXPECT_EQ(queue.try_pop_batch(std::back_inserter(popped), 10), 0);
+
+  // Remaining elements are destroyed with the queue
+  auto shared = std::make_shared<int>(1);
+  {
+    dizing::mpmc_queue<std::shared_ptr<int>, 2> owners;
+    EXPECT_TRUE(owners.try_push(shared));
+    EXPECT_EQ(shared.use_count(), 2);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST_F(MpmcQueueTest, Stress) {
+  for (bool batch : {false, true}) {
+    dizing::mpmc_queue<int, 64> queue;
+    constexpr int kTotal = kThreads * kItemsPerProducer;
+    std::vector<std::atomic<int>> seen(kTotal);
+    std::atomic<int> consumed(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t] {
+        Produce(queue, t * kItemsPerProducer, kItemsPerProducer, batch);
+      });
+      threads.emplace_back([&] {
+        int values[5];
+        while (consumed.load() < kTotal) {
+          std::size_t count = batch ? queue.try_pop_batch(values, 5)
+                                    : queue.try_pop(values[0]);
+          for (std::size_t i = 0; i < count; ++i) {
+            seen[static_cast<std::size_t>(values[i])].fetch_add(1);
+          }
+          if (count == 0) {
+            std::this_thread::yield();
+          }
+          consumed.fetch_add(static_cast<int>(count));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(consumed.load(), kTotal);
+    for (const auto& count : seen) {
+      EXPECT_EQ(count.load(), 1);
+    }
+  }
+}
+
+TEST_F(MpmcQueueTest, FifoPerProducer) {
+  dizing::mpmc_queue<int, 16> queue;
+  std::thread producer([&] { Produce(queue, 0, kItemsPerProducer, true); });
+  int expected = 0;
+  while (expected < kItemsPerProducer) {
+    int value = -1;
+    if (queue.try_pop(value)) {
+      EXPECT_EQ(value, expected);
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+}
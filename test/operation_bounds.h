@@ -0,0 +1,52 @@
+#if !defined(CONTAINERS_TEST_OPERATION_BOUNDS_H)
+#define CONTAINERS_TEST_OPERATION_BOUNDS_H
+
+#include <cstddef>
+#include <limits>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+// Upper bounds of operation_counts fields, all unbounded by default.
+struct OperationBounds {
+  static constexpr std::size_t kUnbounded =
+      std::numeric_limits<std::size_t>::max();
+
+  std::size_t allocations = kUnbounded;
+  std::size_t allocated_bytes = kUnbounded;
+  std::size_t constructions = kUnbounded;
+  std::size_t copies = kUnbounded;
+  std::size_t moves = kUnbounded;
+  std::size_t destructions = kUnbounded;
+
+  // Bounds of an operation which neither allocates nor copies.
+  static OperationBounds NoAllocationsNoCopies() {
+    OperationBounds bounds;
+    bounds.allocations = 0;
+    bounds.copies = 0;
+    return bounds;
+  }
+};
+
+// Expects every count not to exceed its bound.
+inline void ExpectWithinBounds(const dizing::operation_counts& counts,
+                               const OperationBounds& bounds) {
+  EXPECT_LE(counts.allocations, bounds.allocations) << "allocations";
+  EXPECT_LE(counts.allocated_bytes, bounds.allocated_bytes)
+      << "allocated bytes";
+  EXPECT_LE(counts.constructions, bounds.constructions) << "constructions";
+  EXPECT_LE(counts.copies, bounds.copies) << "copies";
+  EXPECT_LE(counts.moves, bounds.moves) << "moves";
+  EXPECT_LE(counts.destructions, bounds.destructions) << "destructions";
+}
+
+// Expects count of operations over elements operations not to exceed
+// per_element on average.
+inline void ExpectAmortizedAtMost(std::size_t count, double per_element,
+                                  std::size_t elements) {
+  EXPECT_LE(static_cast<double>(count),
+            per_element * static_cast<double>(elements))
+      << count << " operations for " << elements << " elements";
+}
+
+#endif  // CONTAINERS_TEST_OPERATION_BOUNDS_H
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+// Run under ThreadSanitizer with make tsan.
+class ParallelTest : public ::testing::Test {
+ protected:
+  // Enough ints for many chunks
+  static constexpr std::size_t kSize = 100000;
+
+  // Pools of a single thread and of several threads.
+  dizing::parallel::thread_pool single_ = dizing::parallel::thread_pool(1);
+  dizing::parallel::thread_pool pool_ = dizing::parallel::thread_pool(4);
+
+  static dizing::vector<int> Sequence(std::size_t size) {
+    dizing::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    return values;
+  }
+};
+
+TEST_F(ParallelTest, ForEachAndTransform) {
+  for (auto *pool : {&single_, &pool_}) {
+    dizing::vector<int> values = Sequence(kSize);
+    dizing::parallel::for_each(*pool, values.begin(), values.end(),
+                               [](int &value) { value *= 2; });
+    for (std::size_t i = 0; i < kSize; ++i) {
+      ASSERT_EQ(values[i], 2 * static_cast<int>(i));
+    }
+
+    dizing::vector<long> squares(kSize);
+    auto end = dizing::parallel::transform(
+        *pool, values.begin(), values.end(), squares.begin(),
+        [](int value) { return static_cast<long>(value) * value; });
+    EXPECT_EQ(end, squares.end());
+    for (std::size_t i = 0; i < kSize; ++i) {
+      ASSERT_EQ(squares[i], 4 * static_cast<long>(i) * static_cast<long>(i));
+    }
+  }
+
+  // Arrays, spans and the default pool
+  dizing::array<int, 5> array = {1, 2, 3, 4, 5};
+  dizing::parallel::for_each(array.begin(), array.end(),
+                             [](int &value) { ++value; });
+  EXPECT_EQ(array[0], 2);
+  EXPECT_EQ(array[4], 6);
+  dizing::span<int> span(array.data(), 3);
+  EXPECT_EQ(dizing::parallel::reduce(span.begin(), span.end(), 0), 9);
+}
+
+TEST_F(ParallelTest, Reduce) {
+  dizing::vector<int> values = Sequence(kSize);
+  for (auto *pool : {&single_, &pool_}) {
+    EXPECT_EQ(dizing::parallel::reduce(*pool, values.begin(), values.end(),
+                                       0L),
+              static_cast<long>(kSize * (kSize - 1) / 2));
+    EXPECT_EQ(dizing::parallel::reduce(
+                  *pool, values.begin(), values.end(), -1,
+                  [](int lhs, int rhs) { return std::max(lhs, rhs); }),
+              static_cast<int>(kSize) - 1);
+    EXPECT_EQ(
+        dizing::parallel::reduce(*pool, values.begin(), values.begin(), 7),
+        7);
+  }
+  // Non commutative operation
+  dizing::vector<std::string> words(kSize, "ab");
+  std::string joined = dizing::parallel::reduce(
+      pool_, words.begin(), words.end(), std::string("<"));
+  EXPECT_EQ(joined.size(), 2 * kSize + 1);
+  EXPECT_EQ(joined.substr(0, 5), "<abab");
+}
+
+TEST_F(ParallelTest, InclusiveScan) {
+  for (auto *pool : {&single_, &pool_}) {
+    for (std::size_t size : {std::size_t{0}, std::size_t{1}, kSize}) {
+      dizing::vector<long> values(size, 1);
+      dizing::vector<long> sums(size);
+      auto end = dizing::parallel::inclusive_scan(
+          *pool, values.begin(), values.end(), sums.begin());
+      EXPECT_EQ(end, sums.end());
+      for (std::size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(sums[i], static_cast<long>(i + 1));
+      }
+      // In place
+      dizing::parallel::inclusive_scan(*pool, sums.begin(), sums.end(),
+                                       sums.begin());
+      for (std::size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(sums[i], static_cast<long>((i + 1) * (i + 2) / 2));
+      }
+    }
+  }
+}
+
+TEST_F(ParallelTest, Sort) {
+  for (auto *pool : {&single_, &pool_}) {
+    for (std::size_t size : {std::size_t{0}, std::size_t{10}, kSize}) {
+      // Pairs of (key, original position) to check stability
+      dizing::vector<std::pair<int, std::size_t>> values(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        values[i] = {static_cast<int>((i * 7919) % 1000), i};
+      }
+      std::vector<std::pair<int, std::size_t>> expected(values.begin(),
+                                                        values.end());
+      std::stable_sort(
+          expected.begin(), expected.end(),
+          [](const auto &lhs, const auto &rhs) {
+            return lhs.first < rhs.first;
+          });
+      dizing::parallel::sort(*pool, values.begin(), values.end(),
+                             [](const auto &lhs, const auto &rhs) {
+                               return lhs.first < rhs.first;
+                             });
+      ASSERT_TRUE(std::equal(values.begin(), values.end(), expected.begin(),
+                             expected.end()));
+    }
+  }
+  dizing::vector<std::string> strings;
+  for (std::size_t i = 0; i < kSize; ++i) {
+    strings.push_back(std::to_string((i * 7919) % kSize));
+  }
+  dizing::parallel::sort(pool_, strings.begin(), strings.end(),
+                         std::greater<>());
+  EXPECT_TRUE(
+      std::is_sorted(strings.begin(), strings.end(), std::greater<>()));
+}
+
+TEST_F(ParallelTest, TaskGroup) {
+  // Nested groups wait by running tasks, so they don't deadlock
+  std::atomic<int> leaves(0);
+  {
+    dizing::parallel::task_group outer(pool_);
+    for (int i = 0; i < 16; ++i) {
+      outer.run([&] {
+        dizing::parallel::task_group inner(pool_);
+        for (int j = 0; j < 16; ++j) {
+          inner.run([&] { leaves.fetch_add(1); });
+        }
+        inner.wait();
+      });
+    }
+    outer.wait();
+  }
+  EXPECT_EQ(leaves.load(), 256);
+
+  // The first exception reaches wait(), other tasks still run
+  std::atomic<int> finished(0);
+  dizing::parallel::task_group group(pool_);
+  for (int i = 0; i < 8; ++i) {
+    group.run([&finished, i] {
+      if (i == 3) {
+        throw std::runtime_error("task failed");
+      }
+      finished.fetch_add(1);
+    });
+  }
+  EXPECT_THROW(group.wait(), std::runtime_error);
+  EXPECT_EQ(finished.load(), 7);
+  dizing::vector<int> values = Sequence(kSize);
+  EXPECT_THROW(dizing::parallel::for_each(pool_, values.begin(), values.end(),
+                                          [](int value) {
+                                            if (value == 5000) {
+                                              throw std::runtime_error("");
+                                            }
+                                          }),
+               std::runtime_error);
+}
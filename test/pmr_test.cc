@@ -0,0 +1,166 @@
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+namespace {
+// Resource counting live upstream allocations.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations = 0;
+  std::size_t live = 0;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    ++live;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override {
+    --live;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+}  // namespace
+
+class PmrTest : public ::testing::Test {
+ protected:
+  CountingResource upstream = CountingResource();
+
+  template <typename Container, typename T>
+  static void check_with_std(const Container& container,
+                             const std::vector<T>& std_vec) {
+    EXPECT_EQ(container.size(), std_vec.size());
+    auto it = container.begin();
+    for (size_t i = 0; i < std_vec.size(); ++i) {
+      EXPECT_EQ(*it, std_vec[i]);
+      ++it;
+    }
+  }
+};
+
+TEST_F(PmrTest, ArenaResource) {
+  dizing::pmr::arena_resource arena(256, &upstream);
+  EXPECT_EQ(upstream.allocations, 0);
+  for (std::size_t alignment : {1u, 2u, 8u, 16u, 64u}) {
+    void* p = arena.allocate(3, alignment);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0);
+  }
+  void* large = arena.allocate(1000, 8);
+  EXPECT_NE(large, nullptr);
+  EXPECT_EQ(arena.block_count(), 2);
+
+  // Used blocks are merged, the next rounds reuse the merged block
+  arena.reset();
+  EXPECT_EQ(arena.block_count(), 1);
+  std::size_t warmed_up = upstream.allocations;
+  for (int round = 0; round < 3; ++round) {
+    EXPECT_NE(arena.allocate(1000, 8), arena.allocate(100, 8));
+    arena.reset();
+  }
+  EXPECT_EQ(upstream.allocations, warmed_up);
+  EXPECT_EQ(upstream.live, 1);
+  arena.release();
+  EXPECT_EQ(upstream.live, 0);
+  EXPECT_TRUE(arena.is_equal(arena));
+}
+
+TEST_F(PmrTest, NestedContainers) {
+  dizing::pmr::arena_resource arena(1024, &upstream);
+  dizing::pmr::vector<dizing::pmr::vector<int>> outer(&arena);
+  outer.emplace_back(3, 7);
+  dizing::pmr::vector<int> from_default = {1, 2};
+  outer.push_back(from_default);
+  outer.push_back(std::move(from_default));
+  for (int i = 0; i < 10; ++i) {
+    outer.emplace_back();
+  }
+  for (const auto& inner : outer) {
+    EXPECT_EQ(inner.get_allocator().resource(), &arena);
+  }
+  check_with_std(outer[0], std::vector<int>{7, 7, 7});
+  check_with_std(outer[1], std::vector<int>{1, 2});
+  check_with_std(outer[2], std::vector<int>{1, 2});
+
+  dizing::pmr::list<dizing::pmr::list<std::pmr::string>> lists(&arena);
+  lists.emplace_back();
+  lists.emplace_back(std::initializer_list<std::pmr::string>{
+      "a long string that must be allocated", "b"});
+  for (const auto& inner : lists) {
+    EXPECT_EQ(inner.get_allocator().resource(), &arena);
+    for (const auto& string : inner) {
+      EXPECT_EQ(string.get_allocator().resource(), &arena);
+    }
+  }
+  EXPECT_EQ(upstream.live, arena.block_count());
+}
+
+TEST_F(PmrTest, VectorPropagation) {
+  dizing::pmr::arena_resource first_arena;
+  dizing::pmr::arena_resource second_arena;
+  dizing::pmr::vector<std::string> first({"a", "b", "c"}, &first_arena);
+  dizing::pmr::vector<std::string> second({"d"}, &second_arena);
+
+  // Copies get the default resource, assignment keeps own resource
+  dizing::pmr::vector<std::string> copy = first;
+  EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+  second = first;
+  EXPECT_EQ(second.get_allocator().resource(), &second_arena);
+  check_with_std(second, std::vector<std::string>{"a", "b", "c"});
+
+  // Different resources: elements are moved one by one
+  second = std::move(copy);
+  EXPECT_EQ(second.get_allocator().resource(), &second_arena);
+  EXPECT_TRUE(copy.empty());
+  check_with_std(second, std::vector<std::string>{"a", "b", "c"});
+
+  dizing::pmr::vector<std::string> moved(std::move(first), &second_arena);
+  EXPECT_TRUE(first.empty());
+  moved.swap(second);
+  EXPECT_EQ(moved.get_allocator().resource(), &second_arena);
+  check_with_std(moved, std::vector<std::string>{"a", "b", "c"});
+}
+
+TEST_F(PmrTest, ListPropagation) {
+  dizing::pmr::arena_resource first_arena;
+  dizing::pmr::arena_resource second_arena;
+  dizing::pmr::list<std::string> first({"a", "b", "c"}, &first_arena);
+  dizing::pmr::list<std::string> second({"d"}, &second_arena);
+
+  dizing::pmr::list<std::string> copy = first;
+  EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+  second = first;
+  EXPECT_EQ(second.get_allocator().resource(), &second_arena);
+  check_with_std(second, std::vector<std::string>{"a", "b", "c"});
+
+  second = std::move(copy);
+  EXPECT_EQ(second.get_allocator().resource(), &second_arena);
+  EXPECT_TRUE(copy.empty());
+  check_with_std(second, std::vector<std::string>{"a", "b", "c"});
+
+  dizing::pmr::list<std::string> moved(std::move(first), &second_arena);
+  EXPECT_TRUE(first.empty());
+  moved.swap(second);
+  EXPECT_EQ(moved.get_allocator().resource(), &second_arena);
+  check_with_std(moved, std::vector<std::string>{"a", "b", "c"});
+
+  // Propagating allocators travel with the nodes
+  using pool = dizing::pool_allocator<int>;
+  pool first_pool;
+  pool second_pool;
+  dizing::list<int, pool> pooled({1, 2}, first_pool);
+  dizing::list<int, pool> other({3}, second_pool);
+  pooled.swap(other);
+  EXPECT_TRUE(pooled.get_allocator() == second_pool);
+  check_with_std(pooled, std::vector<int>{3});
+  pooled = other;
+  EXPECT_TRUE(pooled.get_allocator() == first_pool);
+  check_with_std(pooled, std::vector<int>{1, 2});
+}
@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <list>
+#include <string>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+#include "test_class.h"
+
+class PoolAllocatorTest : public ::testing::Test {
+ protected:
+  using allocator = dizing::pool_allocator<testClass, 8>;
+  using pooled_list = dizing::list<testClass, allocator>;
+
+  template <typename T, typename Allocator>
+  static void check_with_std(const dizing::list<T, Allocator>& ll,
+                             const std::list<T>& stdll) {
+    EXPECT_EQ(ll.size(), stdll.size());
+    auto ll_it = ll.begin();
+    auto stdll_it = stdll.begin();
+    for (size_t i = 0; i < stdll.size(); ++i) {
+      EXPECT_EQ(*ll_it, *stdll_it);
+      ++ll_it;
+      ++stdll_it;
+    }
+  }
+};
+
+TEST_F(PoolAllocatorTest, ListNodes) {
+  allocator alloc;
+  pooled_list ll(alloc);
+  std::list<testClass> stdll;
+  EXPECT_EQ(alloc.slab_count(), 0);
+  for (int i = 0; i < 20; ++i) {
+    ll.push_back({std::to_string(i), "value"});
+    stdll.push_back({std::to_string(i), "value"});
+  }
+  check_with_std(ll, stdll);
+  EXPECT_EQ(alloc.slab_count(), 3);
+  EXPECT_EQ(alloc.free_nodes(), 4);
+  EXPECT_TRUE(ll.get_allocator() == alloc);
+
+  // Queue-like usage reuses freed nodes
+  for (int i = 0; i < 100; ++i) {
+    ll.pop_front();
+    stdll.pop_front();
+    ll.push_back({"next", std::to_string(i)});
+    stdll.push_back({"next", std::to_string(i)});
+  }
+  check_with_std(ll, stdll);
+  EXPECT_EQ(alloc.slab_count(), 3);
+
+  ll.clear();
+  EXPECT_EQ(alloc.free_nodes(), 24);
+  EXPECT_EQ(alloc.slab_count(), 3);
+}
+
+TEST_F(PoolAllocatorTest, ContiguousNodes) {
+  dizing::list<std::int64_t, dizing::pool_allocator<std::int64_t, 8>> ll;
+  for (int i = 0; i < 8; ++i) {
+    ll.push_back(i);
+  }
+  auto it = ll.begin();
+  auto previous = reinterpret_cast<std::uintptr_t>(&*it);
+  for (++it; it != ll.end(); ++it) {
+    auto current = reinterpret_cast<std::uintptr_t>(&*it);
+    EXPECT_GT(current, previous);
+    EXPECT_LE(current - previous, 32);
+    previous = current;
+  }
+}
+
+TEST_F(PoolAllocatorTest, SharedPool) {
+  allocator alloc;
+  pooled_list first({{"a", "b"}, {"c", "d"}}, alloc);
+  pooled_list copy = first;
+  EXPECT_TRUE(copy.get_allocator() == alloc);
+  EXPECT_EQ(alloc.slab_count(), 1);
+  EXPECT_EQ(alloc.free_nodes(), 4);
+
+  pooled_list moved = std::move(first);
+  EXPECT_TRUE(moved.get_allocator() == alloc);
+  first.push_back({"e", "f"});
+  EXPECT_EQ(alloc.free_nodes(), 3);
+
+  // Rebound allocators share the pool, independent allocators don't
+  dizing::pool_allocator<int, 8> rebound(alloc);
+  EXPECT_TRUE(rebound == alloc);
+  int* value = rebound.allocate(1);
+  EXPECT_EQ(alloc.slab_count(), 2);
+  rebound.deallocate(value, 1);
+  int* array = rebound.allocate(100);
+  rebound.deallocate(array, 100);
+  EXPECT_EQ(alloc.slab_count(), 2);
+  EXPECT_FALSE(allocator() == alloc);
+}
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+// Kernels of every instruction set the CPU supports are compared with the
+// std algorithms, on sizes around the vector widths and unaligned data.
+class SimdTest : public ::testing::Test {
+ protected:
+  void TearDown() override { dizing::simd::set_active_isa(initial_); }
+
+  static std::vector<dizing::simd::isa> SupportedIsas() {
+    std::vector<dizing::simd::isa> levels;
+    for (auto level : {dizing::simd::isa::scalar, dizing::simd::isa::sse2,
+                       dizing::simd::isa::avx2, dizing::simd::isa::avx512}) {
+      if (dizing::simd::supported(level)) {
+        levels.push_back(level);
+      }
+    }
+    return levels;
+  }
+
+  template <typename T>
+  static void CheckWithStd() {
+    for (auto level : SupportedIsas()) {
+      ASSERT_TRUE(dizing::simd::set_active_isa(level));
+      for (std::size_t size : {0u, 1u, 3u, 7u, 8u, 15u, 16u, 17u, 31u, 33u,
+                               63u, 64u, 65u, 127u, 129u, 255u, 300u, 1000u,
+                               5000u}) {
+        // Starts one element past the allocation, so it's unaligned
+        dizing::vector<T> storage(size + 1);
+        for (std::size_t i = 0; i < storage.size(); ++i) {
+          storage[i] = static_cast<T>((i * 37 + 11) % 101);
+        }
+        const T *first = storage.begin() + 1;
+        const T *last = first + size;
+        std::vector<T> copy(first, last);
+
+        EXPECT_EQ(dizing::simd::find(first, last, T(50)),
+                  std::find(first, last, T(50)));
+        EXPECT_EQ(dizing::simd::find(first, last, T(127)), last);
+        EXPECT_EQ(dizing::simd::count(first, last, T(48)),
+                  static_cast<std::size_t>(std::count(first, last, T(48))));
+        EXPECT_TRUE(dizing::simd::equal(first, last, copy.data()));
+        if (size > 0) {
+          copy[size / 2] = T(120);
+          EXPECT_FALSE(dizing::simd::equal(first, last, copy.data()));
+          copy[size - 1] = T(121);
+          EXPECT_EQ(dizing::simd::min(copy.data(), copy.data() + size),
+                    *std::min_element(copy.begin(), copy.end()));
+          EXPECT_EQ(dizing::simd::max(copy.data(), copy.data() + size),
+                    *std::max_element(copy.begin(), copy.end()));
+        }
+        EXPECT_EQ(dizing::simd::sum(first, last), Sum(first, last));
+        EXPECT_EQ(dizing::simd::dot(first, last, first), Dot(first, last));
+
+        dizing::simd::fill(storage.begin() + 1, storage.end(), T(9));
+        EXPECT_EQ(std::count(first, last, T(9)),
+                  static_cast<std::ptrdiff_t>(size));
+        EXPECT_EQ(storage[0], T(11));
+      }
+    }
+  }
+
+  // Sequential references, integers wrap around.
+  template <typename T>
+  static T Sum(const T *first, const T *last) {
+    using Acc = dizing::simd_internal::Accumulator<T>;
+    Acc sum = std::accumulate(first, last, Acc(), [](Acc lhs, T rhs) {
+      return static_cast<Acc>(lhs + static_cast<Acc>(rhs));
+    });
+    return static_cast<T>(sum);
+  }
+  template <typename T>
+  static T Dot(const T *first, const T *last) {
+    using Acc = dizing::simd_internal::Accumulator<T>;
+    Acc sum = std::accumulate(first, last, Acc(), [](Acc lhs, T rhs) {
+      auto square = static_cast<Acc>(rhs) * static_cast<Acc>(rhs);
+      return static_cast<Acc>(lhs + static_cast<Acc>(square));
+    });
+    return static_cast<T>(sum);
+  }
+
+ private:
+  dizing::simd::isa initial_ = dizing::simd::active_isa();
+};
+
+TEST_F(SimdTest, CheckWithStd) {
+  CheckWithStd<std::int8_t>();
+  CheckWithStd<std::uint8_t>();
+  CheckWithStd<std::int16_t>();
+  CheckWithStd<std::uint32_t>();
+  CheckWithStd<std::int64_t>();
+  // Values are small integers, so float sums are exact in any order
+  CheckWithStd<float>();
+  CheckWithStd<double>();
+}
+
+TEST_F(SimdTest, CountManyMatches) {
+  // Byte lanes are flushed before they overflow
+  for (auto level : SupportedIsas()) {
+    ASSERT_TRUE(dizing::simd::set_active_isa(level));
+    dizing::vector<std::uint8_t> bytes(100000, 7);
+    EXPECT_EQ(dizing::simd::count(bytes, std::uint8_t{7}), 100000);
+  }
+}
+
+TEST_F(SimdTest, Containers) {
+  for (auto level : SupportedIsas()) {
+    ASSERT_TRUE(dizing::simd::set_active_isa(level));
+    // Below one vector: no dispatch
+    dizing::array<int, 3> small = {4, -2, 9};
+    EXPECT_EQ(dizing::simd::sum(small), 11);
+    EXPECT_EQ(dizing::simd::min(small), -2);
+    EXPECT_EQ(dizing::simd::find(small, 9), small.begin() + 2);
+
+    dizing::array<float, 37> floats = {};
+    dizing::simd::fill(floats, 0.5f);
+    EXPECT_EQ(dizing::simd::sum(floats), 18.5f);
+    EXPECT_EQ(dizing::simd::dot(floats, floats), 9.25f);
+    EXPECT_EQ(dizing::simd::count(floats, 0.5f), 37);
+    EXPECT_TRUE(dizing::simd::equal(floats, floats));
+    floats[36] = 2;
+    EXPECT_EQ(dizing::simd::max(floats), 2);
+    EXPECT_EQ(dizing::simd::find(floats, 2.0f), floats.begin() + 36);
+
+    dizing::vector<long> longs(100);
+    std::iota(longs.begin(), longs.end(), -50);
+    EXPECT_EQ(dizing::simd::sum(longs), -50);
+    EXPECT_EQ(dizing::simd::max(longs), 49);
+    EXPECT_EQ(dizing::simd::find(longs, 0L), longs.begin() + 50);
+    dizing::vector<long> shorter(99);
+    EXPECT_FALSE(dizing::simd::equal(longs, shorter));
+    EXPECT_THROW(dizing::simd::dot(longs, shorter), std::length_error);
+    dizing::simd::fill(shorter, 3L);
+    EXPECT_EQ(dizing::simd::count(shorter, 3L), 99);
+
+    // Other types use the scalar kernels
+    dizing::vector<long double> wide(10, 1.5L);
+    EXPECT_EQ(dizing::simd::sum(wide), 15.0L);
+  }
+}
+
+TEST_F(SimdTest, ValuesConvertToElementType) {
+  dizing::vector<double> doubles(20);
+  dizing::simd::fill(doubles.begin(), doubles.end(), 0);
+  EXPECT_EQ(dizing::simd::count(doubles.begin(), doubles.end(), 0), 20);
+  doubles[5] = 1;
+  EXPECT_EQ(dizing::simd::find(doubles.begin(), doubles.end(), 1),
+            doubles.begin() + 5);
+
+  dizing::vector<float> floats(20);
+  dizing::simd::fill(floats, 1.0);
+  EXPECT_EQ(dizing::simd::count(floats, 1), 20);
+  EXPECT_EQ(dizing::simd::find(floats, 2.0), floats.end());
+
+  dizing::array<long, 20> longs = {};
+  dizing::simd::fill(longs, 3);
+  EXPECT_EQ(dizing::simd::count(longs, 3), 20);
+  EXPECT_EQ(dizing::simd::find(longs, 3), longs.begin());
+}
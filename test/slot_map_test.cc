@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+class SlotMapTest : public ::testing::Test {
+ protected:
+  using Key = dizing::slot_map_key;
+
+  dizing::operation_counts counts = dizing::operation_counts();
+
+  // Every live key finds its value and the dense values are exactly the
+  // values of live keys.
+  template <typename SlotMap>
+  static void check_with_std(const SlotMap &map,
+                             const std::unordered_map<int, Key> &keys) {
+    ASSERT_EQ(map.size(), keys.size());
+    for (const auto &[value, key] : keys) {
+      ASSERT_TRUE(map.contains(key));
+      EXPECT_EQ(map.at(key), value);
+    }
+    std::size_t pos = 0;
+    for (int value : map) {
+      EXPECT_EQ(map.key_at(pos), keys.at(value));
+      ++pos;
+    }
+  }
+};
+
+TEST_F(SlotMapTest, Keys) {
+  dizing::slot_map<std::string> map;
+  EXPECT_TRUE(map.empty());
+  Key a = map.insert("a");
+  Key b = map.emplace(3, 'b');
+  EXPECT_NE(a, b);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map[a], "a");
+  EXPECT_EQ(*map.find(b), "bbb");
+
+  EXPECT_TRUE(map.erase(a));
+  EXPECT_FALSE(map.erase(a));
+  EXPECT_FALSE(map.contains(a));
+  EXPECT_EQ(map.find(a), nullptr);
+  EXPECT_THROW(map.at(a), std::out_of_range);
+  EXPECT_EQ(map.at(b), "bbb");
+
+  // The slot of a is reused with a new generation, a stays invalid
+  Key c = map.insert("c");
+  EXPECT_EQ(c.index, a.index);
+  EXPECT_NE(c, a);
+  EXPECT_FALSE(map.contains(a));
+  EXPECT_EQ(map.at(c), "c");
+  EXPECT_EQ(map.size(), 2);
+
+  const auto &const_map = map;
+  EXPECT_EQ(std::count(const_map.begin(), const_map.end(), "c"), 1);
+  EXPECT_EQ(const_map.end() - const_map.begin(), 2);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains(b));
+  EXPECT_FALSE(map.contains(c));
+  Key d = map.insert("d");
+  EXPECT_EQ(map.at(d), "d");
+  EXPECT_FALSE(map.contains(b));
+}
+
+TEST_F(SlotMapTest, Churn) {
+  dizing::slot_map<int> map;
+  std::unordered_map<int, Key> keys;
+  std::vector<Key> erased;
+  std::mt19937 random(7);
+  int next = 0;
+  for (int i = 0; i < 20000; ++i) {
+    if (keys.empty() || random() % 3 != 0) {
+      keys[next] = map.insert(next);
+      ++next;
+    } else {
+      auto it = keys.begin();
+      std::advance(it, random() % keys.size());
+      EXPECT_TRUE(map.erase(it->second));
+      erased.push_back(it->second);
+      keys.erase(it);
+    }
+  }
+  check_with_std(map, keys);
+  for (Key key : erased) {
+    EXPECT_FALSE(map.contains(key));
+  }
+
+  // Values are edited in place through iteration
+  for (int &value : map) {
+    value = -value;
+  }
+  for (const auto &[value, key] : keys) {
+    EXPECT_EQ(map[key], -value);
+  }
+}
+
+TEST_F(SlotMapTest, Allocator) {
+  {
+    dizing::slot_map<int, dizing::counting_allocator<int>> map{
+        dizing::counting_allocator<int>(counts)};
+    map.reserve(100);
+    std::size_t reserved = counts.allocations;
+    std::vector<Key> keys;
+    for (int i = 0; i < 100; ++i) {
+      keys.push_back(map.insert(i));
+    }
+    for (Key key : keys) {
+      map.erase(key);
+    }
+    for (int i = 0; i < 100; ++i) {
+      map.insert(i);
+    }
+    // Erased slots are reused
+    EXPECT_EQ(counts.allocations, reserved);
+
+    dizing::slot_map<int, dizing::counting_allocator<int>> other{
+        dizing::counting_allocator<int>(counts)};
+    other.swap(map);
+    EXPECT_EQ(other.size(), 100);
+    EXPECT_TRUE(map.empty());
+  }
+  EXPECT_EQ(counts.live_bytes, 0);
+
+  {
+    // Appends grow the vectors geometrically: the values, the slot of
+    // each value and the slot table
+    dizing::slot_map<int, dizing::counting_allocator<int>> map{
+        dizing::counting_allocator<int>(counts)};
+    counts = dizing::operation_counts();
+    constexpr int kLogSize = 14;
+    for (int i = 0; i < (1 << kLogSize); ++i) {
+      map.insert(i);
+    }
+    EXPECT_LE(counts.allocations, 3 * (kLogSize + 1));
+  }
+
+  dizing::pmr::arena_resource arena;
+  dizing::pmr::slot_map<std::pmr::string> map(&arena);
+  Key key = map.emplace("a string longer than the small string buffer");
+  EXPECT_EQ(map.get_allocator().resource(), &arena);
+  EXPECT_EQ(map[key].get_allocator().resource(), &arena);
+}
@@ -0,0 +1,149 @@
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+#include "test_class.h"
+
+namespace {
+// Allocator counting heap allocations of all its instances.
+template <typename T>
+struct HeapCounter {
+  using value_type = T;
+  static inline size_t allocations = 0;
+  HeapCounter() = default;
+  template <typename U>
+  HeapCounter(const HeapCounter<U>&) {}
+  T* allocate(size_t n) {
+    ++allocations;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+  bool operator==(const HeapCounter&) const { return true; }
+  bool operator!=(const HeapCounter&) const { return false; }
+};
+}  // namespace
+
+class SmallVectorTest : public ::testing::Test {
+ protected:
+  SmallVectorTest() { HeapCounter<testClass>::allocations = 0; }
+
+  using small = dizing::small_vector<testClass, 4, HeapCounter<testClass>>;
+
+  template <typename Vector, typename T>
+  static void check_with_std(const Vector& vec, const std::vector<T>& std_vec) {
+    EXPECT_EQ(vec.size(), std_vec.size());
+    auto it = vec.begin();
+    auto std_it = std_vec.begin();
+    for (size_t i = 0; i < std_vec.size(); ++i) {
+      EXPECT_EQ(*it, *std_it);
+      ++it;
+      ++std_it;
+    }
+  }
+
+  static std::vector<testClass> MakeValues(size_t count) {
+    std::vector<testClass> values;
+    for (size_t i = 0; i < count; ++i) {
+      values.emplace_back(std::to_string(i), "value");
+    }
+    return values;
+  }
+};
+
+TEST_F(SmallVectorTest, InlineStorage) {
+  small vec;
+  EXPECT_EQ(vec.capacity(), 4);
+  auto values = MakeValues(4);
+  for (auto& value : values) {
+    vec.push_back(value);
+  }
+  vec.insert_many(vec.begin() + 1);
+  vec.erase(vec.begin());
+  vec.insert(vec.begin(), values[0]);
+  check_with_std(vec, values);
+  EXPECT_EQ(HeapCounter<testClass>::allocations, 0);
+  auto object = reinterpret_cast<const char*>(&vec);
+  auto data = reinterpret_cast<const char*>(vec.data());
+  EXPECT_TRUE(object <= data && data < object + sizeof(vec));
+}
+
+TEST_F(SmallVectorTest, SpillAndShrink) {
+  small vec;
+  std::vector<testClass> std_vec;
+  auto values = MakeValues(10);
+  for (auto& value : values) {
+    vec.push_back(value);
+    std_vec.push_back(value);
+  }
+  EXPECT_EQ(HeapCounter<testClass>::allocations, 2);
+  EXPECT_EQ(vec.capacity(), 16);
+  vec.insert_many_back(testClass("a", "b"), testClass("c", "d"));
+  std_vec.insert(std_vec.end(), {testClass("a", "b"), testClass("c", "d")});
+  check_with_std(vec, std_vec);
+
+  vec.erase(vec.begin() + 1, vec.end() - 1);
+  std_vec.erase(std_vec.begin() + 1, std_vec.end() - 1);
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 4);
+  check_with_std(vec, std_vec);
+}
+
+TEST_F(SmallVectorTest, MoveAndSwap) {
+  auto values = MakeValues(3);
+  auto many_values = MakeValues(8);
+  small inline_vec(values.begin(), values.end());
+  small heap_vec(many_values.begin(), many_values.end());
+  const testClass* heap_data = heap_vec.data();
+
+  // Inline elements are moved one by one
+  testClass::ResetCounters();
+  small moved_inline(std::move(inline_vec));
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 3);
+  EXPECT_EQ(inline_vec.size(), 0);
+  check_with_std(moved_inline, values);
+
+  // Heap buffer is stolen
+  small moved_heap(std::move(heap_vec));
+  EXPECT_EQ(moved_heap.data(), heap_data);
+  EXPECT_EQ(heap_vec.size(), 0);
+  EXPECT_EQ(heap_vec.capacity(), 4);
+  check_with_std(moved_heap, many_values);
+
+  // Move assignment both ways
+  small target(many_values.begin(), many_values.end());
+  target = std::move(moved_inline);
+  check_with_std(target, values);
+  target = std::move(moved_heap);
+  EXPECT_EQ(target.data(), heap_data);
+  check_with_std(target, many_values);
+
+  // Swap of inline and heap vectors
+  small other(values.begin(), values.end());
+  target.swap(other);
+  check_with_std(target, values);
+  check_with_std(other, many_values);
+  EXPECT_EQ(other.data(), heap_data);
+
+  // Copy
+  small copy = other;
+  check_with_std(copy, many_values);
+  copy = target;
+  check_with_std(copy, values);
+}
+
+TEST_F(SmallVectorTest, TrivialElements) {
+  dizing::small_vector<int, 8> vec = {1, 2, 3};
+  vec.insert(vec.begin() + 1, 3, 7);
+  vec.resize(12, 5);
+  vec.erase(vec.begin(), vec.begin() + 2);
+  std::vector<int> std_vec = {1, 2, 3};
+  std_vec.insert(std_vec.begin() + 1, 3, 7);
+  std_vec.resize(12, 5);
+  std_vec.erase(std_vec.begin(), std_vec.begin() + 2);
+  check_with_std(vec, std_vec);
+  dizing::small_vector<int, 8> moved = std::move(vec);
+  check_with_std(moved, std_vec);
+  vec.push_back(1);
+  check_with_std(vec, std::vector<int>{1});
+}
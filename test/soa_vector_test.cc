@@ -0,0 +1,153 @@
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+class SoaVectorTest : public ::testing::Test {
+ protected:
+  using Rows = dizing::soa_vector<std::uint64_t, double, std::string>;
+
+  // Rows are compared field by field with a vector of tuples.
+  static void check_with_std(
+      const Rows &rows,
+      const std::vector<std::tuple<std::uint64_t, double, std::string>>
+          &std_rows) {
+    ASSERT_EQ(rows.size(), std_rows.size());
+    EXPECT_EQ(rows.end() - rows.begin(),
+              static_cast<std::ptrdiff_t>(std_rows.size()));
+    std::size_t i = 0;
+    for (auto [id, value, name] : rows) {
+      EXPECT_EQ(id, std::get<0>(std_rows[i]));
+      EXPECT_EQ(value, std::get<1>(std_rows[i]));
+      EXPECT_EQ(name, std::get<2>(std_rows[i]));
+      ++i;
+    }
+    EXPECT_EQ(rows.column<0>().size(), rows.size());
+    EXPECT_EQ(rows.column<2>().size(), rows.size());
+  }
+};
+
+TEST_F(SoaVectorTest, Modifiers) {
+  Rows rows;
+  std::vector<std::tuple<std::uint64_t, double, std::string>> std_rows;
+  EXPECT_TRUE(rows.empty());
+  for (std::uint64_t i = 0; i < 100; ++i) {
+    auto [id, value, name] =
+        rows.emplace_back(i, 0.5 * static_cast<double>(i), std::to_string(i));
+    EXPECT_EQ(id, i);
+    EXPECT_EQ(name, std::to_string(i));
+    std_rows.emplace_back(i, 0.5 * static_cast<double>(i), std::to_string(i));
+    value += 1;
+    std::get<1>(std_rows.back()) += 1;
+  }
+  check_with_std(rows, std_rows);
+
+  rows.push_back({7, 7.5, "seven"});
+  std::tuple<std::uint64_t, double, std::string> row = {8, 8.5, "eight"};
+  rows.push_back(row);
+  rows.push_back(std::move(row));
+  std_rows.push_back({7, 7.5, "seven"});
+  std_rows.push_back({8, 8.5, "eight"});
+  std_rows.push_back({8, 8.5, "eight"});
+  check_with_std(rows, std_rows);
+
+  // Rows are assigned through the proxy
+  rows[3] = std::make_tuple(std::uint64_t{30}, 3.0, std::string("thirty"));
+  std_rows[3] = {30, 3.0, "thirty"};
+  std::get<2>(rows.front()) = "first";
+  std::get<2>(std_rows.front()) = "first";
+  rows.pop_back();
+  std_rows.pop_back();
+  check_with_std(rows, std_rows);
+
+  rows.reserve(1000);
+  EXPECT_GE(rows.capacity(), 1000);
+  rows.resize(200);
+  std_rows.resize(200);
+  check_with_std(rows, std_rows);
+  rows.shrink_to_fit();
+  check_with_std(rows, std_rows);
+
+  Rows other;
+  other.emplace_back(1, 1.0, "one");
+  rows.swap(other);
+  EXPECT_EQ(rows.size(), 1);
+  check_with_std(other, std_rows);
+  Rows copy = other;
+  check_with_std(copy, std_rows);
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(copy.begin(), copy.end());
+}
+
+TEST_F(SoaVectorTest, Columns) {
+  dizing::soa_vector<std::int32_t, float> rows;
+  for (int i = 0; i < 50; ++i) {
+    rows.emplace_back(i, static_cast<float>(i) / 2);
+  }
+  dizing::span<std::int32_t> ids = rows.column<0>();
+  EXPECT_EQ(ids.size(), 50);
+  EXPECT_EQ(ids[49], 49);
+  EXPECT_EQ(dizing::simd::sum(ids.begin(), ids.end()), 1225);
+  const auto &const_rows = rows;
+  dizing::span<const float> values = const_rows.column<1>();
+  EXPECT_EQ(dizing::simd::max(values.begin(), values.end()), 24.5f);
+  ids[0] = 100;
+  EXPECT_EQ(std::get<0>(const_rows[0]), 100);
+
+  // Iterators are random access
+  auto it = rows.begin() + 10;
+  dizing::soa_vector<std::int32_t, float>::const_iterator const_it = it;
+  EXPECT_EQ(std::get<0>(*const_it), 10);
+  EXPECT_EQ(std::get<1>(it[2]), 6.0f);
+  EXPECT_EQ(rows.end() - it, 40);
+  EXPECT_TRUE(rows.begin() < it);
+}
+
+TEST_F(SoaVectorTest, ThrowingField) {
+  // A field throwing on copy leaves the other columns unchanged
+  struct Bomb {
+    Bomb() = default;
+    Bomb(const Bomb &) { throw std::runtime_error("copy"); }
+    Bomb(Bomb &&) = default;
+    Bomb &operator=(const Bomb &) = default;
+    Bomb &operator=(Bomb &&) = default;
+  };
+  dizing::soa_vector<std::string, Bomb> rows;
+  rows.emplace_back("kept", Bomb());
+  Bomb bomb;
+  EXPECT_THROW(rows.emplace_back("dropped", bomb), std::runtime_error);
+  EXPECT_EQ(rows.size(), 1);
+  EXPECT_EQ(rows.column<0>().size(), 1);
+  EXPECT_EQ(std::get<0>(rows.back()), "kept");
+
+  // A field throwing on value-initialization leaves all columns at the
+  // old size after resize
+  struct Fuse {
+    Fuse() { throw std::runtime_error("value-init"); }
+    explicit Fuse(int) {}
+  };
+  dizing::soa_vector<std::string, Fuse> fused;
+  fused.emplace_back("kept", 1);
+  EXPECT_THROW(fused.resize(5), std::runtime_error);
+  EXPECT_EQ(fused.size(), 1);
+  EXPECT_EQ(fused.column<0>().size(), 1);
+  EXPECT_EQ(fused.column<1>().size(), 1);
+  EXPECT_EQ(std::get<0>(fused.back()), "kept");
+  fused.resize(0);
+  EXPECT_TRUE(fused.empty());
+}
+
+TEST_F(SoaVectorTest, Pmr) {
+  std::pmr::monotonic_buffer_resource resource;
+  dizing::pmr::soa_vector<int, dizing::pmr::vector<int>> rows(&resource);
+  rows.emplace_back(1, dizing::pmr::vector<int>{1, 2, 3});
+  EXPECT_EQ(rows.get_allocator().resource(), &resource);
+  EXPECT_EQ(std::get<1>(rows[0]).get_allocator().resource(), &resource);
+}
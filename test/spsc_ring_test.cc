@@ -0,0 +1,113 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+
+// Run under ThreadSanitizer with make tsan.
+class SpscRingTest : public ::testing::Test {
+ protected:
+  static constexpr std::size_t kMessages = 50000;
+
+  dizing::operation_counts counts = dizing::operation_counts();
+};
+
+TEST_F(SpscRingTest, ReserveCommit) {
+  dizing::spsc_ring<char, 8> ring;
+  EXPECT_EQ(ring.capacity(), 8);
+  EXPECT_TRUE(ring.peek().empty());
+
+  dizing::span<char> slots = ring.reserve(5);
+  ASSERT_EQ(slots.size(), 5);
+  std::memcpy(slots.data(), "hello", 5);
+  // Nothing is visible before commit
+  EXPECT_TRUE(ring.peek().empty());
+  ring.commit(5);
+  dizing::span<char> readable = ring.peek();
+  EXPECT_EQ(std::string(readable.begin(), readable.end()), "hello");
+  ring.release(3);
+  EXPECT_EQ(ring.size_approx(), 2);
+
+  // Spans end at the end of the buffer, free space wraps around
+  EXPECT_EQ(ring.reserve(6).size(), 3);
+  ring.commit(3);
+  EXPECT_EQ(ring.reserve(6).size(), 3);
+  EXPECT_EQ(ring.peek().size(), 5);
+  ring.release(5);
+  EXPECT_EQ(ring.reserve(10).size(), 8);
+  ring.commit(8);
+  EXPECT_TRUE(ring.reserve(1).empty());
+  EXPECT_FALSE(ring.try_push('x'));
+  char value = 0;
+  EXPECT_TRUE(ring.try_pop(value));
+  EXPECT_TRUE(ring.try_push('x'));
+}
+
+TEST_F(SpscRingTest, RuntimeCapacity) {
+  using allocator = dizing::counting_allocator<std::string>;
+  {
+    dizing::spsc_ring<std::string, 0, allocator> ring(3, allocator(counts));
+    EXPECT_EQ(ring.capacity(), 3);
+    EXPECT_TRUE(ring.try_push("a long string that must be allocated"));
+    EXPECT_TRUE(ring.try_push("b"));
+    std::string value;
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, "a long string that must be allocated");
+    EXPECT_EQ(counts.allocations, 1);
+  }
+  EXPECT_EQ(counts.live_bytes, 0);
+  EXPECT_THROW((dizing::spsc_ring<int>(0)), std::length_error);
+  EXPECT_THROW((dizing::spsc_ring<int, 4>(8)), std::length_error);
+}
+
+TEST_F(SpscRingTest, ProducerConsumer) {
+  // Messages of varying length are framed by a length byte
+  dizing::spsc_ring<unsigned char> ring(256);
+  std::thread producer([&] {
+    std::size_t sent = 0;
+    while (sent < kMessages) {
+      std::size_t length = sent % 7 + 1;
+      dizing::span<unsigned char> slots = ring.reserve(length + 1);
+      if (slots.size() < length + 1) {
+        if (!slots.empty()) {
+          // Padding up to the end of the buffer
+          slots[0] = 0;
+          ring.commit(1);
+        }
+        std::this_thread::yield();
+        continue;
+      }
+      slots[0] = static_cast<unsigned char>(length);
+      for (std::size_t i = 1; i <= length; ++i) {
+        slots[i] = static_cast<unsigned char>(sent + i);
+      }
+      ring.commit(length + 1);
+      ++sent;
+    }
+  });
+  std::size_t received = 0;
+  while (received < kMessages) {
+    dizing::span<unsigned char> readable = ring.peek();
+    if (readable.empty()) {
+      std::this_thread::yield();
+      continue;
+    }
+    std::size_t length = readable[0];
+    if (length == 0) {
+      ring.release(1);
+      continue;
+    }
+    ASSERT_GT(readable.size(), length);
+    EXPECT_EQ(length, received % 7 + 1);
+    for (std::size_t i = 1; i <= length; ++i) {
+      EXPECT_EQ(readable[i], static_cast<unsigned char>(received + i));
+    }
+    ring.release(length + 1);
+    ++received;
+  }
+  producer.join();
+  EXPECT_EQ(ring.size_approx(), 0);
+}
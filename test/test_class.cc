@@ -1,5 +1,13 @@
 #include "test_class.h"
 
+std::size_t testClass::copies = 0;
+std::size_t testClass::moves = 0;
+
+void testClass::ResetCounters() {
+  copies = 0;
+  moves = 0;
+}
+
 testClass::testClass() : a(""), b("") {}
 
 testClass::testClass(const std::string& a, const std::string& b) : a(a), b(b) {
@@ -7,11 +15,13 @@ testClass::testClass(const std::string& a, const std::string& b) : a(a), b(b) {
 }
 testClass::testClass(const testClass& other) : a(other.a), b(other.b) {
   // std::cout << "copyConstuctor" << std::endl;
+  ++copies;
 }
 
-testClass::testClass(testClass&& other)
+testClass::testClass(testClass&& other) noexcept
     : a(std::move(other.a)), b(std::move(other.b)) {
   // std::cout << "moveConstuctor" << std::endl;
+  ++moves;
 }
 bool testClass::operator==(const testClass& other) const {
   return other.a == a && other.b == b;
@@ -19,9 +29,16 @@ bool testClass::operator==(const testClass& other) const {
 testClass& testClass::operator=(const testClass& other) {
   a = other.a;
   b = other.b;
+  ++copies;
+  return *this;
+}
+testClass& testClass::operator=(testClass&& other) noexcept {
+  a = std::move(other.a);
+  b = std::move(other.b);
+  ++moves;
   return *this;
 }
 std::ostream& operator<<(std::ostream& stream, const testClass& test_obj) {
   std::cout << test_obj.a << " " << test_obj.b << std::endl;
   return stream;
-}
\ No newline at end of file
+}
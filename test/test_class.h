@@ -9,9 +9,16 @@ struct testClass {
   testClass();
   testClass(const std::string& a, const std::string& b);
   testClass(const testClass& other);
-  testClass(testClass&& other);
+  testClass(testClass&& other) noexcept;
   bool operator==(const testClass& other) const;
   testClass& operator=(const testClass& other);
+  testClass& operator=(testClass&& other) noexcept;
+
+  // Instrumentation: number of copy and move constructions/assignments
+  // since the last ResetCounters() call.
+  static std::size_t copies;
+  static std::size_t moves;
+  static void ResetCounters();
 };
 std::ostream& operator<<(std::ostream& stream, const testClass& test_obj);
 #endif  // CONTAINERS_TEST_TEST_CLASS_H
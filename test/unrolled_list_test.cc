@@ -0,0 +1,229 @@
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "containers.h"
+#include "gtest/gtest.h"
+#include "test_class.h"
+
+class UnrolledListTest : public ::testing::Test {
+ protected:
+  // Small nodes to exercise splits and merges
+  using small_list = dizing::unrolled_list<int, 4>;
+
+  dizing::operation_counts counts = dizing::operation_counts();
+
+  template <typename List, typename T>
+  static void check_with_std(const List& ll, const std::list<T>& stdll) {
+    EXPECT_EQ(ll.size(), stdll.size());
+    auto ll_it = ll.begin();
+    for (const auto& value : stdll) {
+      EXPECT_EQ(*ll_it, value);
+      ++ll_it;
+    }
+    EXPECT_EQ(ll_it, ll.end());
+    // Backwards too
+    auto std_rit = stdll.rbegin();
+    for (auto it = ll.end(); it != ll.begin();) {
+      EXPECT_EQ(*--it, *std_rit++);
+    }
+  }
+};
+
+TEST_F(UnrolledListTest, Constructors) {
+  dizing::unrolled_list<testClass> ll = {{"a", "b"}, {"c", "d"}};
+  std::list<testClass> stdll = {{"a", "b"}, {"c", "d"}};
+  check_with_std(ll, stdll);
+
+  dizing::unrolled_list<testClass> copy(ll);
+  check_with_std(copy, stdll);
+  dizing::unrolled_list<testClass> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  check_with_std(moved, stdll);
+
+  small_list sized(9);
+  check_with_std(sized, std::list<int>(9));
+  EXPECT_EQ(sized.node_count(), 3);
+
+  dizing::unrolled_list<testClass> assigned;
+  assigned = ll;
+  check_with_std(assigned, stdll);
+  assigned = std::move(ll);
+  check_with_std(assigned, stdll);
+  EXPECT_TRUE(ll.empty());
+}
+
+TEST_F(UnrolledListTest, PushPop) {
+  small_list ll;
+  std::list<int> stdll;
+  for (int i = 0; i < 100; ++i) {
+    if (i % 3 == 0) {
+      ll.push_front(i);
+      stdll.push_front(i);
+    } else {
+      ll.push_back(i);
+      stdll.push_back(i);
+    }
+  }
+  check_with_std(ll, stdll);
+  EXPECT_EQ(ll.front(), stdll.front());
+  EXPECT_EQ(ll.back(), stdll.back());
+  for (int i = 0; i < 60; ++i) {
+    if (i % 2 == 0) {
+      ll.pop_front();
+      stdll.pop_front();
+    } else {
+      ll.pop_back();
+      stdll.pop_back();
+    }
+  }
+  check_with_std(ll, stdll);
+  ll.clear();
+  EXPECT_TRUE(ll.empty());
+  EXPECT_EQ(ll.node_count(), 0);
+}
+
+TEST_F(UnrolledListTest, InsertErase) {
+  small_list ll;
+  std::list<int> stdll;
+  for (int i = 0; i < 40; ++i) {
+    ll.push_back(i);
+    stdll.push_back(i);
+  }
+  // Inserting into full nodes splits them
+  auto it = std::next(ll.begin(), 10);
+  auto std_it = std::next(stdll.begin(), 10);
+  for (int i = 0; i < 20; ++i) {
+    it = ll.insert(it, -i);
+    std_it = stdll.insert(std_it, -i);
+    EXPECT_EQ(*it, *std_it);
+    if (i % 3 == 0) {
+      ++it;
+      ++std_it;
+    }
+  }
+  check_with_std(ll, stdll);
+
+  // Erasing merges sparse nodes
+  std::size_t nodes = ll.node_count();
+  it = std::next(ll.begin(), 5);
+  std_it = std::next(stdll.begin(), 5);
+  for (int i = 0; i < 30; ++i) {
+    it = ll.erase(it);
+    std_it = stdll.erase(std_it);
+    if (std_it != stdll.end()) {
+      EXPECT_EQ(*it, *std_it);
+    }
+    if (i % 4 == 0) {
+      ++it;
+      ++std_it;
+    }
+  }
+  check_with_std(ll, stdll);
+  EXPECT_LT(ll.node_count(), nodes);
+
+  it = ll.erase(std::next(ll.begin(), 2), std::prev(ll.end(), 2));
+  std_it = stdll.erase(std::next(stdll.begin(), 2), std::prev(stdll.end(), 2));
+  EXPECT_EQ(*it, *std_it);
+  check_with_std(ll, stdll);
+  EXPECT_EQ(ll.erase(ll.begin(), ll.end()), ll.end());
+  EXPECT_TRUE(ll.empty());
+}
+
+TEST_F(UnrolledListTest, SelfInsert) {
+  // Splitting the full node moves the argument into the new node
+  dizing::unrolled_list<std::string, 4> ll;
+  std::list<std::string> stdll;
+  for (char c : {'a', 'b', 'c', 'd'}) {
+    ll.push_back(std::string(40, c));
+    stdll.push_back(std::string(40, c));
+  }
+  ll.insert(ll.begin(), *std::next(ll.begin(), 3));
+  stdll.insert(stdll.begin(), *std::next(stdll.begin(), 3));
+  check_with_std(ll, stdll);
+  ll.emplace(std::next(ll.begin(), 3), ll.back());
+  stdll.emplace(std::next(stdll.begin(), 3), stdll.back());
+  check_with_std(ll, stdll);
+}
+
+TEST_F(UnrolledListTest, Packing) {
+  dizing::unrolled_list<int> ll;
+  for (int i = 0; i < 10000; ++i) {
+    ll.push_back(i);
+  }
+  constexpr std::size_t kCapacity = dizing::unrolled_list<int>::kNodeCapacity;
+  EXPECT_GE(kCapacity, 32);
+  EXPECT_EQ(ll.node_count(), (10000 + kCapacity - 1) / kCapacity);
+
+  // Front insertion keeps nodes at least half full
+  small_list front;
+  for (int i = 0; i < 100; ++i) {
+    front.push_front(i);
+  }
+  EXPECT_LE(front.node_count(), 50);
+}
+
+TEST_F(UnrolledListTest, Splice) {
+  small_list ll = {1, 2, 3, 4, 5, 6};
+  small_list other = {7, 8, 9};
+  // Node of pos is split, nodes of other are relinked
+  ll.splice(std::next(ll.begin()), other);
+  check_with_std(ll, std::list<int>{1, 7, 8, 9, 2, 3, 4, 5, 6});
+  EXPECT_TRUE(other.empty());
+  other.push_back(10);
+  ll.splice(ll.end(), other);
+  ll.splice(ll.begin(), small_list{0});
+  check_with_std(ll, std::list<int>{0, 1, 7, 8, 9, 2, 3, 4, 5, 6, 10});
+  ll.swap(other);
+  EXPECT_TRUE(ll.empty());
+  EXPECT_EQ(other.size(), 11);
+}
+
+TEST_F(UnrolledListTest, ExceptionSafety) {
+  struct Throwing {
+    explicit Throwing(int value) : value_(value) {
+      if (value < 0) {
+        throw std::invalid_argument("negative");
+      }
+    }
+    int value_;
+  };
+  using allocator = dizing::counting_allocator<Throwing>;
+  dizing::unrolled_list<Throwing, 4, allocator> ll{allocator(counts)};
+  EXPECT_THROW(ll.emplace_back(-1), std::invalid_argument);
+  EXPECT_TRUE(ll.empty());
+  EXPECT_EQ(ll.node_count(), 0);
+  for (int i = 0; i < 4; ++i) {
+    ll.emplace_back(i);
+  }
+  EXPECT_THROW(ll.emplace_front(-1), std::invalid_argument);
+  EXPECT_EQ(ll.size(), 4);
+  EXPECT_EQ(ll.front().value_, 0);
+  ll.clear();
+  EXPECT_EQ(counts.live_bytes, 0);
+}
+
+TEST_F(UnrolledListTest, Propagation) {
+  dizing::pmr::arena_resource first_arena;
+  dizing::pmr::arena_resource second_arena;
+  using pmr_list = dizing::pmr::unrolled_list<std::string, 4>;
+  pmr_list first({"a", "b", "c"}, &first_arena);
+  pmr_list second({"d"}, &second_arena);
+
+  pmr_list copy = first;
+  EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+  second = first;
+  EXPECT_EQ(second.get_allocator().resource(), &second_arena);
+  check_with_std(second, std::list<std::string>{"a", "b", "c"});
+
+  second = std::move(copy);
+  EXPECT_EQ(second.get_allocator().resource(), &second_arena);
+  EXPECT_TRUE(copy.empty());
+  check_with_std(second, std::list<std::string>{"a", "b", "c"});
+
+  pmr_list moved(std::move(first), &second_arena);
+  EXPECT_TRUE(first.empty());
+  check_with_std(moved, std::list<std::string>{"a", "b", "c"});
+}
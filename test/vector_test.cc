@@ -1,4 +1,12 @@
+#include <array>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "containers.h"
@@ -9,9 +17,8 @@ class VectorTest : public ::testing::Test {
  protected:
   VectorTest() {}
 
-  template <typename T>
-  static void check_with_std(const dizing::vector<T>& vec,
-                             const std::vector<T>& std_vec) {
+  template <typename Vector, typename T>
+  static void check_with_std(const Vector& vec, const std::vector<T>& std_vec) {
     EXPECT_EQ(vec.size(), std_vec.size());
     auto it = vec.begin();
     auto std_it = std_vec.begin();
@@ -39,7 +46,7 @@ TEST_F(VectorTest, ConstructorTest) {
   check_with_std(vec_copy_constructor, std_vec_copy_constructor);
 
   dizing::vector vec_move_constructor(std::move(vec_copy_constructor));
-  std::vector std_vec_move_constructor(std::move(std_from_rvalue_list));
+  std::vector std_vec_move_constructor(std::move(std_vec_copy_constructor));
   check_with_std(vec_copy_constructor, std_vec_copy_constructor);
   check_with_std(vec_move_constructor, std_vec_move_constructor);
 }
@@ -126,4 +133,396 @@ TEST_F(VectorTest, InsertMany) {
       {"uno", "map"},    {"Maron", "Kubanov"}, {"1", "2"},
       {"all", "is end"}, {"Maron", "Kubanov"}, {"zoo", "park"}};
   check_with_std(test_vector, check_vector);
-}
\ No newline at end of file
+}
+namespace {
+// Stateful allocator that doesn't propagate on move assignment.
+// Allocators with different ids can't free memory of each other.
+template <typename T>
+struct TaggedAllocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::false_type;
+  int id;
+  explicit TaggedAllocator(int id = 0) : id(id) {}
+  template <typename U>
+  TaggedAllocator(const TaggedAllocator<U>& other) : id(other.id) {}
+  T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+  void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+  bool operator==(const TaggedAllocator& other) const {
+    return id == other.id;
+  }
+  bool operator!=(const TaggedAllocator& other) const {
+    return !(*this == other);
+  }
+};
+
+// Element type whose move constructor may throw.
+// Vector must copy it during reallocation to keep the strong guarantee.
+struct ThrowingMove {
+  static inline int copies = 0;
+  static inline int moves = 0;
+  int value;
+  explicit ThrowingMove(int v) : value(v) {}
+  ThrowingMove(const ThrowingMove& other) : value(other.value) { ++copies; }
+  ThrowingMove(ThrowingMove&& other) : value(other.value) { ++moves; }
+};
+}  // namespace
+
+TEST_F(VectorTest, Reallocation) {
+  dizing::vector<testClass> vec;
+  std::vector<testClass> std_vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(testClass(std::to_string(i), std::string(32, 'x')));
+    std_vec.push_back(testClass(std::to_string(i), std::string(32, 'x')));
+  }
+  check_with_std(vec, std_vec);
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), vec.size());
+  check_with_std(vec, std_vec);
+
+  // Move-only element type.
+  dizing::vector<std::unique_ptr<int>> unique_vec;
+  for (int i = 0; i < 100; ++i) {
+    unique_vec.push_back(std::make_unique<int>(i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(*unique_vec[static_cast<size_t>(i)], i);
+  }
+
+  // Potentially throwing move falls back to copying.
+  dizing::vector<ThrowingMove> throwing_vec;
+  throwing_vec.reserve(1);
+  throwing_vec.push_back(ThrowingMove(1));
+  ThrowingMove::copies = 0;
+  ThrowingMove::moves = 0;
+  throwing_vec.reserve(16);
+  EXPECT_EQ(ThrowingMove::copies, 1);
+  EXPECT_EQ(ThrowingMove::moves, 0);
+  EXPECT_EQ(throwing_vec[0].value, 1);
+}
+
+TEST_F(VectorTest, MoveSemantics) {
+  dizing::vector<testClass> vec = {{"a", "b"}, {"c", "d"}, {"e", "f"}};
+  std::vector<testClass> std_vec = {{"a", "b"}, {"c", "d"}, {"e", "f"}};
+  testClass* buffer = vec.data();
+  testClass::ResetCounters();
+
+  // MOVE CONSTRUCTOR
+  dizing::vector<testClass> moved(std::move(vec));
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 0);
+  EXPECT_EQ(moved.data(), buffer);
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_EQ(vec.capacity(), 0);
+  check_with_std(moved, std_vec);
+
+  // MOVE ASSIGNMENT
+  dizing::vector<testClass> assigned = {{"old", "value"}};
+  testClass::ResetCounters();
+  assigned = std::move(moved);
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 0);
+  EXPECT_EQ(assigned.data(), buffer);
+  EXPECT_EQ(moved.size(), 0);
+  check_with_std(assigned, std_vec);
+
+  // Moved-from vector is still usable
+  moved.push_back(testClass("g", "h"));
+  check_with_std(moved, std::vector<testClass>{{"g", "h"}});
+
+  // Nested vectors are relocated without touching elements
+  EXPECT_TRUE(std::is_nothrow_move_constructible_v<dizing::vector<testClass>>);
+  std::vector<dizing::vector<testClass>> nested;
+  testClass::ResetCounters();
+  for (int i = 0; i < 64; ++i) {
+    nested.push_back(dizing::vector<testClass>());
+    nested.back().push_back(testClass("x", "y"));
+  }
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 64);
+}
+
+TEST_F(VectorTest, MoveAssignmentAllocatorPropagation) {
+  using tagged_vector = dizing::vector<testClass, TaggedAllocator<testClass>>;
+  tagged_vector source{TaggedAllocator<testClass>(1)};
+  source.push_back(testClass("a", "b"));
+  source.push_back(testClass("c", "d"));
+  tagged_vector source_copy = source;
+  testClass* buffer = source.data();
+
+  // Equal allocators: buffer is stolen
+  tagged_vector equal_target{TaggedAllocator<testClass>(1)};
+  testClass::ResetCounters();
+  equal_target = std::move(source);
+  EXPECT_EQ(equal_target.data(), buffer);
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 0);
+
+  // Different allocators: elements are moved one by one
+  tagged_vector unequal_target{TaggedAllocator<testClass>(2)};
+  testClass::ResetCounters();
+  unequal_target = std::move(source_copy);
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 2);
+  EXPECT_EQ(source_copy.size(), 0);
+  check_with_std(unequal_target,
+                 std::vector<testClass>{{"a", "b"}, {"c", "d"}});
+}
+
+TEST_F(VectorTest, InPlaceInsertErase) {
+  dizing::vector<testClass> vec;
+  std::vector<testClass> std_vec;
+  vec.reserve(64);
+  for (int i = 0; i < 10; ++i) {
+    vec.push_back(testClass(std::to_string(i), "v"));
+    std_vec.push_back(testClass(std::to_string(i), "v"));
+  }
+  testClass* buffer = vec.data();
+
+  // ERASE: tail is moved left, nothing is copied
+  testClass::ResetCounters();
+  auto erased = vec.erase(vec.begin() + 3);
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 6);
+  std_vec.erase(std_vec.begin() + 3);
+  EXPECT_EQ(erased, vec.begin() + 3);
+  check_with_std(vec, std_vec);
+
+  // ERASE RANGE
+  testClass::ResetCounters();
+  erased = vec.erase(vec.begin() + 1, vec.begin() + 4);
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 5);
+  std_vec.erase(std_vec.begin() + 1, std_vec.begin() + 4);
+  EXPECT_EQ(erased, vec.begin() + 1);
+  EXPECT_EQ(vec.erase(vec.end(), vec.end()), vec.end());
+  check_with_std(vec, std_vec);
+
+  // INSERT COUNT: longer and shorter than the tail
+  testClass value("new", "value");
+  vec.insert(vec.begin() + 4, 3, value);
+  std_vec.insert(std_vec.begin() + 4, 3, value);
+  check_with_std(vec, std_vec);
+  vec.insert(vec.begin() + 1, 2, value);
+  std_vec.insert(std_vec.begin() + 1, 2, value);
+  check_with_std(vec, std_vec);
+
+  // INSERT RANGE
+  std::list<testClass> source = {{"l1", "l"}, {"l2", "l"}, {"l3", "l"}};
+  auto inserted = vec.insert(vec.begin() + 2, source.begin(), source.end());
+  std_vec.insert(std_vec.begin() + 2, source.begin(), source.end());
+  EXPECT_EQ(inserted, vec.begin() + 2);
+  check_with_std(vec, std_vec);
+  vec.insert(vec.end(), {testClass("i1", "i"), testClass("i2", "i")});
+  std_vec.insert(std_vec.end(), {testClass("i1", "i"), testClass("i2", "i")});
+  check_with_std(vec, std_vec);
+
+  // INSERT ELEMENT OF ITSELF
+  vec.insert(vec.begin(), vec[5]);
+  std_vec.insert(std_vec.begin(), std_vec[5]);
+  vec.insert(vec.begin() + 2, 2, vec.back());
+  std_vec.insert(std_vec.begin() + 2, 2, std_vec.back());
+  check_with_std(vec, std_vec);
+
+  // Capacity was enough for everything above
+  EXPECT_EQ(vec.data(), buffer);
+  EXPECT_EQ(vec.capacity(), 64);
+
+  vec.insert_many(vec.begin() + 1, vec[0], vec[3]);
+  std_vec.insert(std_vec.begin() + 1, {std_vec[0], std_vec[3]});
+  check_with_std(vec, std_vec);
+
+  // Capacity exceeded
+  std::vector<testClass> many(100, value);
+  vec.insert(vec.begin() + 3, many.begin(), many.end());
+  std_vec.insert(std_vec.begin() + 3, many.begin(), many.end());
+  check_with_std(vec, std_vec);
+}
+
+TEST_F(VectorTest, InPlaceInsertEraseTrivial) {
+  dizing::vector<int> vec = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<int> std_vec = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  vec.reserve(32);
+  int* buffer = vec.data();
+  vec.erase(vec.begin() + 2, vec.begin() + 5);
+  std_vec.erase(std_vec.begin() + 2, std_vec.begin() + 5);
+  vec.insert(vec.begin() + 1, 4, 42);
+  std_vec.insert(std_vec.begin() + 1, 4, 42);
+  vec.insert(vec.begin(), vec[6]);
+  std_vec.insert(std_vec.begin(), std_vec[6]);
+  std::istringstream input("7 8 9");
+  vec.insert(vec.begin() + 5, std::istream_iterator<int>(input),
+             std::istream_iterator<int>());
+  std_vec.insert(std_vec.begin() + 5, {7, 8, 9});
+  vec.erase(vec.end() - 1);
+  std_vec.erase(std_vec.end() - 1);
+  check_with_std(vec, std_vec);
+  EXPECT_EQ(vec.data(), buffer);
+}
+
+TEST_F(VectorTest, Emplace) {
+  dizing::vector<testClass> vec;
+  std::vector<testClass> std_vec;
+  vec.reserve(16);
+
+  // EMPLACE_BACK: constructed in place, nothing is moved or copied
+  testClass::ResetCounters();
+  testClass& back = vec.emplace_back("1", "2");
+  vec.emplace_back();
+  EXPECT_EQ(testClass::copies, 0);
+  EXPECT_EQ(testClass::moves, 0);
+  EXPECT_EQ(&back, vec.data());
+  std_vec.emplace_back("1", "2");
+  std_vec.emplace_back();
+
+  // EMPLACE
+  auto it = vec.emplace(vec.begin() + 1, "3", "4");
+  std_vec.emplace(std_vec.begin() + 1, "3", "4");
+  EXPECT_EQ(it, vec.begin() + 1);
+  it = vec.emplace(vec.end(), "5", "6");
+  std_vec.emplace(std_vec.end(), "5", "6");
+  EXPECT_EQ(it, vec.end() - 1);
+  check_with_std(vec, std_vec);
+
+  // Arguments referring to own elements
+  vec.emplace(vec.begin(), vec[2].a, vec[1].b);
+  std_vec.emplace(std_vec.begin(), std_vec[2].a, std_vec[1].b);
+  vec.shrink_to_fit();
+  vec.emplace_back(vec.front());
+  std_vec.emplace_back(std_vec.front());
+  vec.push_back(vec[1]);
+  std_vec.push_back(std_vec[1]);
+  check_with_std(vec, std_vec);
+}
+
+TEST_F(VectorTest, InsertManyConstructorArguments) {
+  dizing::vector<std::string> vec = {"first", "last"};
+  std::string_view view = "view";
+  auto it = vec.insert_many(vec.begin() + 1, "literal", std::string(3, 'x'),
+                            view);
+  EXPECT_EQ(it, vec.begin() + 1);
+  vec.insert_many_back("back", view);
+  check_with_std(vec, std::vector<std::string>{"first", "literal", "xxx",
+                                               "view", "last", "back",
+                                               "view"});
+}
+
+TEST_F(VectorTest, ResizeAndAssign) {
+  // COUNT CONSTRUCTORS
+  dizing::vector<int> zeros(5);
+  check_with_std(zeros, std::vector<int>(5));
+  dizing::vector<int> fives(4, 5);
+  check_with_std(fives, std::vector<int>(4, 5));
+  dizing::vector<testClass> objects(3, testClass("a", "b"));
+  check_with_std(objects, std::vector<testClass>(3, testClass("a", "b")));
+
+  // RESIZE
+  dizing::vector<testClass> vec = {{"1", "1"}, {"2", "2"}, {"3", "3"}};
+  std::vector<testClass> std_vec = {{"1", "1"}, {"2", "2"}, {"3", "3"}};
+  vec.resize(6);
+  std_vec.resize(6);
+  check_with_std(vec, std_vec);
+  vec.resize(2);
+  std_vec.resize(2);
+  check_with_std(vec, std_vec);
+  vec.resize(20, vec[1]);
+  std_vec.resize(20, std_vec[1]);
+  check_with_std(vec, std_vec);
+
+  // ASSIGN
+  testClass* buffer = vec.data();
+  vec.assign(7, testClass("x", "y"));
+  std_vec.assign(7, testClass("x", "y"));
+  check_with_std(vec, std_vec);
+  std::list<testClass> source = {{"l1", "l"}, {"l2", "l"}};
+  vec.assign(source.begin(), source.end());
+  std_vec.assign(source.begin(), source.end());
+  check_with_std(vec, std_vec);
+  EXPECT_EQ(vec.data(), buffer);
+  vec.assign(40, vec[0]);
+  std_vec.assign(40, std_vec[0]);
+  check_with_std(vec, std_vec);
+  vec.assign({testClass("i", "l")});
+  std_vec.assign({testClass("i", "l")});
+  check_with_std(vec, std_vec);
+
+  dizing::vector<int> ints;
+  std::istringstream input("1 2 3");
+  ints.assign(std::istream_iterator<int>(input), std::istream_iterator<int>());
+  check_with_std(ints, std::vector<int>{1, 2, 3});
+}
+
+TEST_F(VectorTest, DefaultInitAppend) {
+  dizing::vector<char> buffer = {'a', 'b'};
+  char* tail = buffer.append_uninitialized(4);
+  EXPECT_EQ(buffer.size(), 6);
+  EXPECT_EQ(tail, buffer.data() + 2);
+  std::memcpy(tail, "cdef", 4);
+  check_with_std(buffer, std::vector<char>{'a', 'b', 'c', 'd', 'e', 'f'});
+
+  buffer.resize_default_init(3);
+  check_with_std(buffer, std::vector<char>{'a', 'b', 'c'});
+  buffer.resize_default_init(1000);
+  EXPECT_EQ(buffer.size(), 1000);
+  EXPECT_EQ(buffer[2], 'c');
+
+  // Non-trivial types are value-initialized
+  dizing::vector<std::string> strings = {"a"};
+  strings.append_uninitialized(2);
+  check_with_std(strings, std::vector<std::string>{"a", "", ""});
+}
+
+namespace {
+// Distinct capacities a vector passes through while growing to count.
+template <typename Vector>
+std::vector<size_t> CapacityHistory(size_t count) {
+  Vector vec;
+  std::vector<size_t> history;
+  for (size_t i = 0; i < count; ++i) {
+    vec.emplace_back();
+    if (history.empty() || history.back() != vec.capacity()) {
+      history.push_back(vec.capacity());
+    }
+  }
+  return history;
+}
+}  // namespace
+
+TEST_F(VectorTest, GrowthPolicies) {
+  using default_vector = dizing::vector<int>;
+  EXPECT_EQ(CapacityHistory<default_vector>(9),
+            (std::vector<size_t>{1, 2, 4, 8, 16}));
+
+  using min_capacity_vector =
+      dizing::vector<int, std::allocator<int>, dizing::doubling_growth<8>>;
+  EXPECT_EQ(CapacityHistory<min_capacity_vector>(20),
+            (std::vector<size_t>{8, 16, 32}));
+
+  using one_and_half_vector =
+      dizing::vector<int, std::allocator<int>, dizing::one_and_half_growth<4>>;
+  EXPECT_EQ(CapacityHistory<one_and_half_vector>(20),
+            (std::vector<size_t>{4, 6, 9, 13, 19, 28}));
+
+  using page_vector =
+      dizing::vector<char, std::allocator<char>,
+                     dizing::page_rounded_growth<1024>>;
+  auto page_history = CapacityHistory<page_vector>(10000);
+  EXPECT_EQ(page_history.front(), 1024);
+  for (size_t capacity : page_history) {
+    EXPECT_TRUE(capacity < 4096 || capacity % 4096 == 0);
+  }
+  EXPECT_EQ(page_history.back(), 12288);
+
+  using size_class_vector =
+      dizing::vector<std::array<char, 24>, std::allocator<std::array<char, 24>>,
+                     dizing::size_class_growth<>>;
+  EXPECT_EQ(CapacityHistory<size_class_vector>(30),
+            (std::vector<size_t>{1, 2, 3, 4, 6, 9, 13, 21, 32}));
+  EXPECT_EQ(dizing::size_class_growth<>::RoundToSizeClass(100), 112);
+  EXPECT_EQ(dizing::size_class_growth<>::RoundToSizeClass(129), 160);
+  EXPECT_EQ(dizing::size_class_growth<>::RoundToSizeClass(1025), 1280);
+
+  // Reserving more than the policy suggests is honored
+  dizing::vector<int, std::allocator<int>, dizing::one_and_half_growth<>> vec;
+  vec.insert(vec.end(), 100, 1);
+  EXPECT_EQ(vec.capacity(), 100);
+}